@@ -0,0 +1,124 @@
+/**
+ * Micro-benchmarks for the overview's layout and hit-testing hot paths.
+ * Build with `meson setup build -Dbenchmarks=true`, run `build/bench/layout-bench`.
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "layout.hpp"
+
+using namespace wf::overview;
+
+static const wf::dimensions_t AREA = {1920, 1080};
+static const wf::geometry_t PREVIEW = {192, 60, 1536, 864};
+static constexpr int GAP = 40, SPACING = 20;
+
+static std::vector<wf::geometry_t> random_windows(int n) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> w(200, 1900), h(150, 1060), x(0, 400), y(0, 300);
+  std::vector<wf::geometry_t> v(n);
+  for (auto &g : v) g = {x(rng), y(rng), w(rng), h(rng)};
+  return v;
+}
+
+static void BM_gnome_grid(benchmark::State &state) {
+  int n = state.range(0), c, r;
+  for (auto _ : state) {
+    layout::gnome_grid(n, 16.0f / 9.0f, c, r);
+    benchmark::DoNotOptimize(c); benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_gnome_grid)->Arg(1)->Arg(10)->Arg(50)->Arg(200);
+
+// Share of the workspace covered by the laid-out windows, i.e. how readable they are
+static double coverage(const std::vector<wf::geometry_t> &target) {
+  double a = 0; for (auto &g : target) a += (double)g.width * g.height;
+  return a / ((double)AREA.width * AREA.height);
+}
+
+static void BM_arrange_grid(benchmark::State &state) {
+  int n = state.range(0);
+  auto orig = random_windows(n); std::vector<wf::geometry_t> target(n);
+  for (auto _ : state) {
+    layout::arrange_grid(n, AREA, (float)PREVIEW.width / PREVIEW.height, SPACING,
+      [&] (int i) { return orig[i]; }, [&] (int i, wf::geometry_t g) { target[i] = g; });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["coverage"] = coverage(target);
+}
+BENCHMARK(BM_arrange_grid)->Arg(10)->Arg(50)->Arg(200)->Arg(500);
+
+static void BM_arrange_rows(benchmark::State &state) {
+  int n = state.range(0);
+  auto orig = random_windows(n); std::vector<wf::geometry_t> target(n);
+  for (auto _ : state) {
+    layout::arrange_rows(n, AREA, SPACING, [&] (int i) { return orig[i]; }, [&] (int i, wf::geometry_t g) { target[i] = g; });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["coverage"] = coverage(target);
+}
+BENCHMARK(BM_arrange_rows)->Arg(10)->Arg(50)->Arg(200)->Arg(500);
+
+// Pointer motion over the focused workspace: one slot lookup per sample point
+static void BM_slot_hit_test(benchmark::State &state) {
+  int n = state.range(0);
+  auto orig = random_windows(n); std::vector<wf::geometry_t> slots(n);
+  layout::arrange_rows(n, AREA, SPACING, [&] (int i) { return orig[i]; }, [&] (int i, wf::geometry_t g) { slots[i] = g; });
+  std::mt19937 rng(7); std::uniform_real_distribution<float> px(0, AREA.width), py(0, AREA.height);
+  std::vector<wf::pointf_t> pts(1024); for (auto &p : pts) p = {px(rng), py(rng)};
+  size_t k = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(layout::topmost_at(n, pts[k++ & 1023], [&] (int i) { return slots[i]; }));
+  }
+}
+BENCHMARK(BM_slot_hit_test)->Arg(10)->Arg(50)->Arg(200);
+
+static void BM_slot_grid_hit_test(benchmark::State &state) {
+  int n = state.range(0);
+  auto orig = random_windows(n); std::vector<wf::geometry_t> slots(n);
+  layout::arrange_rows(n, AREA, SPACING, [&] (int i) { return orig[i]; }, [&] (int i, wf::geometry_t g) { slots[i] = g; });
+  layout::rect_grid_t grid; grid.build(n, [&] (int i) { return slots[i]; });
+  std::mt19937 rng(7); std::uniform_real_distribution<float> px(0, AREA.width), py(0, AREA.height);
+  std::vector<wf::pointf_t> pts(1024); for (auto &p : pts) p = {px(rng), py(rng)};
+  size_t k = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(grid.topmost_at(pts[k++ & 1023]));
+}
+BENCHMARK(BM_slot_grid_hit_test)->Arg(10)->Arg(50)->Arg(200);
+
+static void BM_slot_grid_build(benchmark::State &state) {
+  int n = state.range(0);
+  auto orig = random_windows(n); std::vector<wf::geometry_t> slots(n);
+  layout::arrange_rows(n, AREA, SPACING, [&] (int i) { return orig[i]; }, [&] (int i, wf::geometry_t g) { slots[i] = g; });
+  layout::rect_grid_t grid;
+  for (auto _ : state) { grid.build(n, [&] (int i) { return slots[i]; }); benchmark::ClobberMemory(); }
+}
+BENCHMARK(BM_slot_grid_build)->Arg(10)->Arg(50)->Arg(200);
+
+static void BM_carousel_hit_test(benchmark::State &state) {
+  int n = state.range(0);
+  std::mt19937 rng(3); std::uniform_real_distribution<float> px(0, AREA.width), py(0, AREA.height);
+  std::vector<wf::pointf_t> pts(1024); for (auto &p : pts) p = {px(rng), py(rng)};
+  float scroll = (n / 2) * (PREVIEW.width + GAP) - PREVIEW.x;
+  size_t k = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(layout::carousel_at(n, pts[k++ & 1023], scroll, PREVIEW, GAP));
+}
+BENCHMARK(BM_carousel_hit_test)->Arg(1)->Arg(9)->Arg(25);
+
+static void BM_thumb_hit_test(benchmark::State &state) {
+  int n = state.range(0);
+  int th = AREA.height / 10, tw = th * AREA.width / AREA.height, sp = SPACING / 2;
+  int x0 = (AREA.width - (n * tw + (n - 1) * sp)) / 2, y0 = AREA.height - SPACING * 2 - th;
+  std::vector<wf::geometry_t> thumbs(n);
+  for (int i = 0; i < n; i++) thumbs[i] = {x0 + i * (tw + sp), y0, tw, th};
+  std::mt19937 rng(5); std::uniform_real_distribution<float> px(0, AREA.width), py(y0 - th, AREA.height);
+  std::vector<wf::pointf_t> pts(1024); for (auto &p : pts) p = {px(rng), py(rng)};
+  size_t k = 0;
+  for (auto _ : state) benchmark::DoNotOptimize(layout::uniform_row_at(n, pts[k++ & 1023], thumbs[0], tw + sp));
+}
+BENCHMARK(BM_thumb_hit_test)->Arg(1)->Arg(9)->Arg(25);
+
+BENCHMARK_MAIN();
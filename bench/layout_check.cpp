@@ -0,0 +1,98 @@
+/**
+ * Correctness checks for the layout code the benchmarks time: every target is
+ * inside its area and no two overlap, over the output sizes people actually use,
+ * and the hit-testing shortcuts agree with the linear scans they replace.
+ * Built with the benchmarks, run with `meson test -C build`.
+ */
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "layout.hpp"
+
+using namespace wf::overview;
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { if (!(cond)) { failures++; std::printf(__VA_ARGS__); std::printf("\n"); } } while (0)
+
+static std::vector<wf::geometry_t> random_windows(std::mt19937 &rng, int n) {
+  std::uniform_int_distribution<int> w(1, 2500), h(1, 1500), x(-500, 2500), y(-300, 1700);
+  std::vector<wf::geometry_t> v(n);
+  for (auto &g : v) g = {x(rng), y(rng), w(rng), h(rng)};
+  return v;
+}
+
+static bool overlap(const wf::geometry_t &a, const wf::geometry_t &b) {
+  return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static void check_rows(const std::vector<wf::geometry_t> &orig, wf::dimensions_t area, int spacing) {
+  int n = orig.size();
+  std::vector<wf::geometry_t> target(n); std::vector<bool> placed(n);
+  layout::arrange_rows(n, area, spacing, [&] (int i) { return orig[i]; },
+    [&] (int i, wf::geometry_t g) { target[i] = g; placed[i] = true; });
+  for (int i = 0; i < n; i++) {
+    auto &g = target[i];
+    CHECK(placed[i], "rows %dx%d/%d n=%d: window %d not placed", area.width, area.height, spacing, n, i);
+    CHECK(g.width > 0 && g.height > 0 && g.x >= spacing && g.y >= spacing &&
+      g.x + g.width <= area.width - spacing && g.y + g.height <= area.height - spacing,
+      "rows %dx%d/%d n=%d: window %d at %d,%d %dx%d outside", area.width, area.height, spacing, n, i,
+      g.x, g.y, g.width, g.height);
+  }
+  for (int i = 0; i < n; i++) for (int j = i + 1; j < n; j++) {
+    CHECK(!overlap(target[i], target[j]), "rows %dx%d/%d n=%d: windows %d and %d overlap",
+      area.width, area.height, spacing, n, i, j);
+  }
+}
+
+// The grid must answer exactly like the linear scan, fractional points on edges included
+static void check_grid(std::mt19937 &rng, int n) {
+  std::vector<wf::geometry_t> rects(n);
+  for (auto &g : rects) g = {(int)(rng() % 1900), (int)(rng() % 1000), (int)(rng() % 600), (int)(rng() % 500)};
+  layout::rect_grid_t grid; grid.build(n, [&] (int i) { return rects[i]; });
+  for (int k = 0; k < 500; k++) {
+    wf::pointf_t p = {(double)(rng() % 2600) - 100 + (rng() % 100) / 100.0, (double)(rng() % 1600) - 100 + (rng() % 100) / 100.0};
+    if (n && k % 4 == 0) {
+      // Just short of some rectangle's far corner
+      auto &g = rects[rng() % n];
+      p = {g.x + g.width - (rng() % 100 + 1) / 128.0, g.y + g.height - (rng() % 100 + 1) / 128.0};
+    }
+    int linear = layout::topmost_at(n, p, [&] (int i) { return rects[i]; }), fast = grid.topmost_at(p);
+    CHECK(linear == fast, "grid n=%d p=%.2f,%.2f: linear %d, grid %d", n, p.x, p.y, linear, fast);
+  }
+}
+
+// Same for the carousel, whose previews overlap by a pixel where truncation flips sign
+static void check_carousel(std::mt19937 &rng) {
+  int n = 1 + rng() % 25, gap = rng() % 100; float scroll = (rng() % 20000) / 3.0f - 2000;
+  wf::geometry_t preview = {(int)(rng() % 300), (int)(rng() % 200), 100 + (int)(rng() % 1500), 100 + (int)(rng() % 800)};
+  for (int k = 0; k < 300; k++) {
+    wf::pointf_t p = {(double)(rng() % 4000) - 1000 + (rng() % 100) / 100.0, (double)(rng() % 1200)};
+    int linear = -1;
+    for (int i = 0; i < n && linear < 0; i++) if (layout::contains(layout::carousel_geo(i, scroll, preview, gap), p)) linear = i;
+    int fast = layout::carousel_at(n, p, scroll, preview, gap);
+    CHECK(linear == fast, "carousel n=%d p=%.2f,%.2f: linear %d, carousel %d", n, p.x, p.y, linear, fast);
+  }
+}
+
+int main() {
+  std::mt19937 rng(42);
+  const wf::dimensions_t outputs[] = {{1920, 1080}, {1080, 1920}, {1366, 768}, {1280, 800}, {3840, 2160}};
+  for (auto area : outputs) for (int spacing : {20, 50}) {
+    for (int n : {1, 2, 3, 10, 50, 200, 300, 500}) check_rows(random_windows(rng, n), area, spacing);
+  }
+  for (int trial = 0; trial < 300; trial++) {
+    wf::dimensions_t area = {200 + (int)(rng() % 3000), 150 + (int)(rng() % 2000)};
+    check_rows(random_windows(rng, 1 + rng() % 500), area, 5 + rng() % 46);
+    // Maximized windows all share one geometry, so their order only comes from the sort
+    check_rows(std::vector<wf::geometry_t>(1 + rng() % 400, wf::geometry_t{0, 0, 1920, 1080}), area, 5 + rng() % 46);
+  }
+
+  for (int trial = 0; trial < 2000; trial++) check_grid(rng, rng() % 60);
+  for (int trial = 0; trial < 2000; trial++) check_carousel(rng);
+
+  if (failures) std::printf("%d failures\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,275 @@
+/**
+ * Overview layout and hit-testing, kept free of compositor state so the hot
+ * paths can be benchmarked on their own (see bench/layout_bench.cpp).
+ *
+ * Copyright (c) 2025
+ * Licensed under MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <wayfire/geometry.hpp>
+
+namespace wf {
+namespace overview {
+namespace layout {
+
+// GNOME-like column/row count for n windows in an area of the given aspect ratio
+inline void gnome_grid(int n, float area_aspect, int &cols, int &rows) {
+  if (n <= 0) { cols = rows = 1; return; } if (n == 1) { cols = rows = 1; return; }
+  if (n == 2) { cols = 2; rows = 1; return; } if (n == 3) { cols = 3; rows = 1; return; }
+  float best_score = 1e9f; int best_c = 2, best_r = 1;
+  for (int c = 2; c <= std::min(n, 6); c++) {
+    int r = (n + c - 1) / c; float ga = (float)c / r;
+    float rd = std::abs(ga - area_aspect) / area_aspect;
+    float ep = (float)(c * r - n) / n * 0.5f; float sc = rd + ep;
+    if (sc < best_score) { best_score = sc; best_c = c; best_r = r; }
+  }
+  cols = best_c; rows = best_r;
+}
+
+// Lays n windows out on a grid inside a workspace of size area, each scaled to fit
+// its cell. orig(i) returns window i's geometry, out(i, geo) receives its target.
+template<class Orig, class Out>
+void arrange_grid(int n, wf::dimensions_t area, float preview_aspect, int spacing, Orig orig, Out out) {
+  if (n <= 0) return;
+  int cols, rows;
+  gnome_grid(n, preview_aspect, cols, rows);
+
+  int inset_x = spacing, inset_y = spacing, inset_bot = spacing;
+  int waw = area.width - inset_x * 2, wah = area.height - inset_y - inset_bot, gap = spacing;
+  int cw = (waw - gap * (cols - 1)) / cols, ch = (wah - gap * (rows - 1)) / rows;
+  int gh = rows * ch + (rows - 1) * gap;
+  int gy = inset_y + (wah - gh) / 2;
+
+  for (int i = 0; i < n; i++) {
+    wf::geometry_t g = orig(i); int row = i / cols;
+    int itr = (row == rows - 1) ? (n - row * cols) : cols;
+    int row_w = itr * cw + (itr - 1) * gap;
+    int row_x = (area.width - row_w) / 2;
+    int cir = i - row * cols;
+    int cx = row_x + cir * (cw + gap), cy = gy + row * (ch + gap);
+    double sc = std::min((double)cw / g.width, (double)ch / g.height) * 0.95;
+    int sw = (int)(g.width * sc), sh = (int)(g.height * sc);
+    out(i, wf::geometry_t{cx + (cw - sw) / 2, cy + (ch - sh) / 2, sw, sh});
+  }
+}
+
+// Justified-rows packing: windows keep their aspect ratio and are split, in reading
+// order of their original centres, into rows whose windows share one height and span
+// the width. Every row count up to about 2 sqrt(n) (more if none fits) is tried and the
+// one covering the most area wins, so many windows still get large thumbnails.
+// O(n sqrt n), no column cap. Gaps shrink with the row and column count so they never
+// eat the area; targets are whole pixels inside the area minus spacing, never overlapping.
+template<class Orig, class Out>
+void arrange_rows(int n, wf::dimensions_t area, int spacing, Orig orig, Out out) {
+  if (n <= 0) return;
+  float W = area.width - spacing * 2, H = area.height - spacing * 2;
+  if (W < 1 || H < 1) return;
+  // Extreme aspect ratios are clamped for packing, the window is then fitted into its box
+  std::vector<int> order(n); std::vector<float> aspect(n), true_aspect(n);
+  for (int i = 0; i < n; i++) {
+    auto g = orig(i); order[i] = i;
+    true_aspect[i] = (float)std::max(g.width, 1) / std::max(g.height, 1);
+    aspect[i] = std::clamp(true_aspect[i], 0.2f, 5.0f);
+  }
+  std::stable_sort(order.begin(), order.end(), [&] (int a, int b) {
+    auto ga = orig(a), gb = orig(b); return ga.y * 2 + ga.height < gb.y * 2 + gb.height;
+  });
+  float total_a = 0; for (float a : aspect) total_a += a;
+
+  // Splits order into r rows of about total_a / r aspect each; row k is [breaks[k], breaks[k + 1])
+  auto split = [&] (int r, std::vector<int> &breaks) {
+    breaks.assign(1, 0); float target = total_a / r, acc = 0;
+    for (int k = 0; k < n; k++) {
+      float a = aspect[order[k]];
+      int rows_left = r - (int)breaks.size() + 1;
+      // Close the row when this window would overshoot more than it falls short,
+      // but never leave more rows than windows
+      if (k > breaks.back() && rows_left > 1 && (acc + a / 2 > target || n - k <= rows_left - 1)) { breaks.push_back(k); acc = 0; }
+      acc += a;
+    }
+    breaks.push_back(n);
+  };
+  // Row heights fitting each row to W, then all scaled down together to fit H. Returns
+  // the covered area, or -1 if the gaps leave no room or some box is under a pixel.
+  std::vector<float> row_a, narrowest;
+  auto heights = [&] (const std::vector<int> &breaks, float gap, std::vector<float> &h) {
+    int rows = (int)breaks.size() - 1; float sum = 0, cover = 0;
+    h.resize(rows); row_a.resize(rows); narrowest.resize(rows);
+    for (int k = 0; k < rows; k++) {
+      float a = 0, m = 1e9f;
+      for (int j = breaks[k]; j < breaks[k + 1]; j++) { a += aspect[order[j]]; m = std::min(m, aspect[order[j]]); }
+      float room = W - gap * (breaks[k + 1] - breaks[k] - 1);
+      if (room <= 0) return -1.0f;
+      h[k] = room / a; sum += h[k]; row_a[k] = a; narrowest[k] = m;
+    }
+    float avail = H - gap * (rows - 1);
+    if (avail <= 0) return -1.0f;
+    if (sum > avail) for (auto &x : h) x *= avail / sum;
+    for (int k = 0; k < rows; k++) {
+      if (h[k] < 1 || narrowest[k] * h[k] < 1) return -1.0f;
+      cover += row_a[k] * h[k] * h[k];
+    }
+    return cover;
+  };
+  // Rounds every row to pixel boxes and fits each window into its box. Boxes are
+  // floored at both edges, so neighbours at most touch.
+  auto place = [&] (const std::vector<int> &breaks, const std::vector<float> &h, float gap) {
+    int rows = (int)breaks.size() - 1;
+    float total_h = gap * (rows - 1); for (float x : h) total_h += x;
+    float y = spacing + std::max(H - total_h, 0.0f) / 2;
+    for (int k = 0; k < rows; k++) {
+      int b = breaks[k], e = breaks[k + 1]; float rh = h[k], row_w = gap * (e - b - 1);
+      for (int j = b; j < e; j++) row_w += aspect[order[j]] * rh;
+      int bt = (int)std::floor(y), bb = (int)std::floor(y + rh);
+      float x = spacing + std::max(W - row_w, 0.0f) / 2;
+      for (int j = b; j < e; j++) {
+        int i = order[j]; float w = aspect[i] * rh;
+        int bl = (int)std::floor(x), br = (int)std::floor(x + w);
+        float sw = std::min(w, rh * true_aspect[i]), sh = std::min(rh, w / true_aspect[i]);
+        int l = std::clamp((int)std::floor(x + (w - sw) / 2), bl, br - 1), r = std::clamp((int)std::floor(x + (w + sw) / 2), l + 1, br);
+        int t = std::clamp((int)std::floor(y + (rh - sh) / 2), bt, bb - 1), bo = std::clamp((int)std::floor(y + (rh + sh) / 2), t + 1, bb);
+        out(i, wf::geometry_t{l, t, r - l, bo - t});
+        x += w + gap;
+      }
+      y += rh + gap;
+    }
+  };
+
+  std::vector<int> breaks, best_breaks; std::vector<float> h, best_h;
+  float best_cover = -1, best_gap = 0;
+  auto search = [&] {
+    int max_rows = std::min(n, 2 * (int)std::ceil(std::sqrt((float)n)) + 1);
+    for (int r = 1; r <= n && (r <= max_rows || best_cover < 0); r++) {
+      split(r, breaks);
+      int rows = (int)breaks.size() - 1, cols = 1;
+      for (int k = 0; k < rows; k++) cols = std::max(cols, breaks[k + 1] - breaks[k]);
+      // Every gap stays below a quarter of the average cell it separates
+      float gap = std::min({(float)spacing, H / (4.0f * rows), W / (4.0f * cols)});
+      float cover = heights(breaks, gap, h);
+      if (cover > best_cover) { best_cover = cover; best_breaks = breaks; best_h = h; best_gap = gap; }
+    }
+  };
+  search();
+  if (best_cover < 0) {
+    // Too crowded for narrow windows to keep a pixel of width: fall back to equal boxes
+    std::fill(aspect.begin(), aspect.end(), 1.0f); total_a = n;
+    search();
+  }
+  if (best_cover < 0) {
+    // Fewer pixels than windows: nothing readable fits, stack them in the middle
+    for (int i = 0; i < n; i++) out(i, wf::geometry_t{area.width / 2, area.height / 2, 1, 1});
+    return;
+  }
+
+  int rows = (int)best_breaks.size() - 1;
+  for (int k = 0; k < rows; k++) {
+    std::sort(order.begin() + best_breaks[k], order.begin() + best_breaks[k + 1], [&] (int p, int q) {
+      auto gp = orig(p), gq = orig(q); return gp.x * 2 + gp.width < gq.x * 2 + gq.width;
+    });
+  }
+  place(best_breaks, best_h, best_gap);
+}
+
+inline bool contains(const wf::geometry_t &g, wf::pointf_t p) {
+  return p.x >= g.x && p.x < g.x + g.width && p.y >= g.y && p.y < g.y + g.height;
+}
+
+// Index of the topmost (last) of n rectangles containing p, -1 if none
+template<class GeoAt>
+int topmost_at(int n, wf::pointf_t p, GeoAt geo) {
+  for (int i = n - 1; i >= 0; i--) if (contains(geo(i), p)) return i;
+  return -1;
+}
+
+// Geometry of carousel preview i at the given scroll, preview being the unscrolled slot 0
+inline wf::geometry_t carousel_geo(int i, float scroll, wf::geometry_t preview, int gap) {
+  float rx = i * (preview.width + gap) - scroll;
+  return {(int)rx, preview.y, preview.width, preview.height};
+}
+
+// Carousel preview under p (screen-local), -1 if none. Previews are evenly spaced,
+// so the candidate follows from p.x directly; neighbours cover the pixel truncation.
+// Truncation toward zero can overlap two previews by a pixel, the lower index wins.
+inline int carousel_at(int n, wf::pointf_t p, float scroll, wf::geometry_t preview, int gap) {
+  float step = preview.width + gap;
+  if (n <= 0 || step <= 0) return -1;
+  int i = (int)std::floor((p.x + scroll) / step);
+  for (int k : {i - 1, i, i + 1}) if (k >= 0 && k < n && contains(carousel_geo(k, scroll, preview, gap), p)) return k;
+  return -1;
+}
+
+// Rectangle under p in a row of n equal rectangles starting at first, step apart in x
+inline int uniform_row_at(int n, wf::pointf_t p, wf::geometry_t first, int step) {
+  if (n <= 0) return -1;
+  if (n == 1 || step <= 0) return contains(first, p) ? 0 : -1;
+  int i = (int)std::floor((p.x - first.x) / step);
+  if (i < 0 || i >= n) return -1;
+  wf::geometry_t g = {first.x + i * step, first.y, first.width, first.height};
+  return contains(g, p) ? i : -1;
+}
+
+// Uniform grid over a set of possibly overlapping rectangles. Each cell lists the
+// rectangles touching it in index order, so a lookup only tests the few in p's cell.
+class rect_grid_t {
+  static constexpr int DIM = 16;
+  wf::geometry_t bounds{};
+  float cw = 1, ch = 1;
+  std::vector<uint32_t> cell_start;  // CSR offsets into items, DIM * DIM + 1 entries
+  std::vector<int> items;
+  std::vector<wf::geometry_t> rects;
+
+  // Column or row of coordinate v; queries and inserts share it so they round alike
+  static int cell_of(double v, int origin, float size) {
+    return std::clamp((int)std::floor((v - origin) / size), 0, DIM - 1);
+  }
+
+  // Cells a rectangle touches. The far edge is exclusive for contains(), but any point
+  // just short of it can round into the edge's own cell, so that cell is included too.
+  void cell_range(const wf::geometry_t &g, int &x0, int &y0, int &x1, int &y1) const {
+    x0 = cell_of(g.x, bounds.x, cw); x1 = cell_of(g.x + g.width, bounds.x, cw);
+    y0 = cell_of(g.y, bounds.y, ch); y1 = cell_of(g.y + g.height, bounds.y, ch);
+  }
+
+public:
+  template<class GeoAt>
+  void build(int n, GeoAt geo) {
+    rects.resize(std::max(n, 0));
+    for (int i = 0; i < n; i++) rects[i] = geo(i);
+    cell_start.assign(DIM * DIM + 1, 0); items.clear();
+    if (n <= 0) return;
+    int l = rects[0].x, t = rects[0].y, r = l + rects[0].width, b = t + rects[0].height;
+    for (auto &g : rects) { l = std::min(l, g.x); t = std::min(t, g.y); r = std::max(r, g.x + g.width); b = std::max(b, g.y + g.height); }
+    bounds = {l, t, std::max(r - l, 1), std::max(b - t, 1)};
+    cw = (float)bounds.width / DIM; ch = (float)bounds.height / DIM;
+    int x0, y0, x1, y1;
+    for (auto &g : rects) {
+      cell_range(g, x0, y0, x1, y1);
+      for (int y = y0; y <= y1; y++) for (int x = x0; x <= x1; x++) cell_start[y * DIM + x + 1]++;
+    }
+    for (int c = 0; c < DIM * DIM; c++) cell_start[c + 1] += cell_start[c];
+    items.resize(cell_start.back());
+    std::vector<uint32_t> fill(cell_start.begin(), cell_start.end() - 1);
+    for (int i = 0; i < n; i++) {
+      cell_range(rects[i], x0, y0, x1, y1);
+      for (int y = y0; y <= y1; y++) for (int x = x0; x <= x1; x++) items[fill[y * DIM + x]++] = i;
+    }
+  }
+
+  // Topmost (highest index) rectangle containing p, -1 if none
+  int topmost_at(wf::pointf_t p) const {
+    if (rects.empty() || !contains(bounds, p)) return -1;
+    int c = cell_of(p.y, bounds.y, ch) * DIM + cell_of(p.x, bounds.x, cw);
+    for (uint32_t k = cell_start[c + 1]; k > cell_start[c]; k--) if (contains(rects[items[k - 1]], p)) return items[k - 1];
+    return -1;
+  }
+};
+
+} // namespace layout
+} // namespace overview
+} // namespace wf
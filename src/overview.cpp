@@ -16,19 +16,30 @@
  * Licensed under MIT
  */
 
+#include <EGL/egl.h>
 #include <cairo.h>
 #include <linux/input-event-codes.h>
 #include <pango/pangocairo.h>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
 #include <ctime>
+#include <deque>
 #include <dirent.h>
 #include <fstream>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <memory>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 #include <wayfire/core.hpp>
 #include <wayfire/geometry.hpp>
@@ -49,7 +60,13 @@
 #include <wayfire/view.hpp>
 #include <wayfire/workspace-set.hpp>
 #include <wayfire/workspace-stream.hpp>
+#include <wayland-server-core.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
+#include "layout.hpp"
 
 #ifndef GL_BGRA_EXT
 #define GL_BGRA_EXT 0x80E1
@@ -64,39 +81,91 @@ static const std::string TRANSFORMER_NAME = "wayfire-overview";
 // Simple Animation Helper
 // ============================================================================
 
+// All animations of an overview live here as parallel arrays. tick() samples the clock
+// once per frame and runs the ease over every entry in one flat loop; the running
+// count makes "is anything still moving" O(1). Start times are ms since the engine was
+// made, kept in double so a long-running compositor does not lose frame precision.
+class anim_engine_t {
+  std::vector<float> val, start, goal, inv_dur;
+  std::vector<double> t0;  // < 0: starts on the next tick
+  std::vector<uint8_t> running;
+  std::vector<uint32_t> free_ids;
+  std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+  int n_running = 0;
+public:
+  uint32_t alloc(float v) {
+    uint32_t id;
+    if (!free_ids.empty()) { id = free_ids.back(); free_ids.pop_back(); }
+    else {
+      id = (uint32_t)val.size();
+      val.push_back(0); start.push_back(0); goal.push_back(0); t0.push_back(0); inv_dur.push_back(0); running.push_back(0);
+    }
+    val[id] = start[id] = goal[id] = v; inv_dur[id] = 1.0f / 300.0f; running[id] = 0;
+    return id;
+  }
+  void release(uint32_t id) { stop(id); free_ids.push_back(id); }
+
+  void set_duration(uint32_t id, float ms) { inv_dur[id] = 1.0f / std::max(ms, 1.0f); }
+  void animate_to(uint32_t id, float g) {
+    start[id] = val[id]; goal[id] = g; t0[id] = -1.0f;
+    if (!running[id]) { running[id] = 1; n_running++; }
+  }
+  void warp(uint32_t id, float v) { val[id] = start[id] = goal[id] = v; stop(id); }
+  float value(uint32_t id) const { return val[id]; }
+  float target(uint32_t id) const { return goal[id]; }
+  bool is_animating(uint32_t id) const { return running[id]; }
+  int active() const { return n_running; }
+
+  void tick() {
+    if (n_running == 0) return;
+    double now = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - epoch).count();
+    size_t n = val.size(); int done = 0;
+    for (size_t i = 0; i < n; i++) {
+      float r = running[i];
+      t0[i] = ((r > 0) & (t0[i] < 0)) ? now : t0[i];
+      float t = std::clamp((float)(now - t0[i]) * inv_dur[i], 0.0f, 1.0f);
+      float u = 1.0f - t, ease = 1.0f - u * u * u;
+      uint8_t fin = running[i] & (t >= 1.0f);
+      // Finished entries land exactly on their goal, not on start + (goal - start) * 1
+      val[i] = fin ? goal[i] : r > 0 ? start[i] + (goal[i] - start[i]) * ease : val[i];
+      running[i] &= !fin; done += fin;
+    }
+    n_running -= done;
+  }
+
+private:
+  void stop(uint32_t id) { if (running[id]) { running[id] = 0; n_running--; } }
+};
+
+// Handle to one engine entry; owns the entry and is move-only
 class anim_t {
-  float val, start, goal, duration_ms;
-  std::chrono::steady_clock::time_point start_time;
-  bool animating = false;
+  anim_engine_t *eng = nullptr;
+  uint32_t id = 0;
 public:
-  anim_t(float v = 0) : val(v), start(v), goal(v), duration_ms(300) {}
-  void set_duration(float ms) { duration_ms = ms; }
-  void animate_to(float g) {
-    start = val; goal = g;
-    start_time = std::chrono::steady_clock::now();
-    animating = true;
-  }
-  void warp(float v) { val = start = goal = v; animating = false; }
-  bool tick() {
-    if (!animating) return false;
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration<float, std::milli>(now - start_time).count();
-    float t = std::clamp(elapsed / duration_ms, 0.0f, 1.0f);
-    float ease = 1.0f - std::pow(1.0f - t, 3.0f);
-    val = start + (goal - start) * ease;
-    if (t >= 1.0f) { val = goal; animating = false; }
-    return animating;
-  }
-  float value() const { return val; }
-  bool is_animating() const { return animating; }
+  explicit anim_t(anim_engine_t &e, float v = 0) : eng(&e), id(e.alloc(v)) {}
+  anim_t(anim_t &&o) noexcept : eng(o.eng), id(o.id) { o.eng = nullptr; }
+  anim_t &operator=(anim_t &&o) noexcept {
+    if (this != &o) { if (eng) eng->release(id); eng = o.eng; id = o.id; o.eng = nullptr; }
+    return *this;
+  }
+  anim_t(const anim_t&) = delete;
+  anim_t &operator=(const anim_t&) = delete;
+  ~anim_t() { if (eng) eng->release(id); }
+
+  void set_duration(float ms) { eng->set_duration(id, ms); }
+  void animate_to(float g) { eng->animate_to(id, g); }
+  void warp(float v) { eng->warp(id, v); }
+  float value() const { return eng->value(id); }
+  float target() const { return eng->target(id); }
+  bool is_animating() const { return eng->is_animating(id); }
 };
 
 struct anim_geo_t {
   anim_t x, y, w, h;
+  explicit anim_geo_t(anim_engine_t &e) : x(e), y(e), w(e), h(e) {}
   void set_duration(float ms) { x.set_duration(ms); y.set_duration(ms); w.set_duration(ms); h.set_duration(ms); }
   void animate_to(wf::geometry_t g) { x.animate_to(g.x); y.animate_to(g.y); w.animate_to(g.width); h.animate_to(g.height); }
   void warp(wf::geometry_t g) { x.warp(g.x); y.warp(g.y); w.warp(g.width); h.warp(g.height); }
-  bool tick() { bool a = x.tick(), b = y.tick(), c = w.tick(), d = h.tick(); return a || b || c || d; }
   wf::geometry_t current() const { return {(int)x.value(), (int)y.value(), (int)w.value(), (int)h.value()}; }
   bool is_animating() const { return x.is_animating() || y.is_animating() || w.is_animating() || h.is_animating(); }
 };
@@ -110,127 +179,226 @@ static bool file_exists(const std::string &p) {
   return stat(p.c_str(), &st) == 0;
 }
 
-static std::string icon_from_desktop_file(const std::string &path) {
+// Returns a desktop entry's Icon= and StartupWMClass= values
+static void parse_desktop_entry(const std::string &path, std::string &icon, std::string &wm_class) {
   std::ifstream f(path);
-  if (!f.is_open()) return "";
+  if (!f.is_open()) return;
   std::string line;
   bool in_entry = false;
   while (std::getline(f, line)) {
     if (line.find("[Desktop Entry]") != std::string::npos) { in_entry = true; continue; }
     if (line.size() > 0 && line[0] == '[') { if (in_entry) break; continue; }
-    if (in_entry && line.compare(0, 5, "Icon=") == 0)
-      return line.substr(5);
+    if (!in_entry) continue;
+    if (line.compare(0, 5, "Icon=") == 0) icon = line.substr(5);
+    else if (line.compare(0, 15, "StartupWMClass=") == 0) wm_class = line.substr(15);
   }
-  return "";
 }
 
-static std::string find_icon_name_for_app(const std::string &app_id) {
+static std::string to_lower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+  return s;
+}
+
+static std::vector<std::string> application_dirs() {
   std::vector<std::string> dirs = {"/usr/share/applications", "/usr/local/share/applications"};
   const char *home = getenv("HOME");
   if (home) dirs.push_back(std::string(home) + "/.local/share/applications");
   dirs.push_back("/var/lib/flatpak/exports/share/applications");
   if (home) dirs.push_back(std::string(home) + "/.local/share/flatpak/exports/share/applications");
+  return dirs;
+}
+
+// Calls fn(name) for every entry of dir ending in suffix, with the suffix stripped
+template<class F> static void for_each_file(const std::string &dir, const std::string &suffix, F fn) {
+  DIR *d = opendir(dir.c_str());
+  if (!d) return;
+  while (auto ent = readdir(d)) {
+    std::string name = ent->d_name;
+    if (name.size() <= suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) continue;
+    fn(name.substr(0, name.size() - suffix.size()));
+  }
+  closedir(d);
+}
+
+// ============================================================================
+// Icon Index — desktop entries and icon themes scanned once, looked up by hash
+// ============================================================================
 
-  for (auto &dir : dirs) {
-    std::string path = dir + "/" + app_id + ".desktop";
-    auto icon = icon_from_desktop_file(path);
-    if (!icon.empty()) return icon;
-  }
-
-  std::string lower_id = app_id;
-  std::transform(lower_id.begin(), lower_id.end(), lower_id.begin(), ::tolower);
-
-  for (auto &dir : dirs) {
-    DIR *d = opendir(dir.c_str());
-    if (!d) continue;
-    struct dirent *ent;
-    while ((ent = readdir(d)) != nullptr) {
-      std::string name = ent->d_name;
-      if (name.size() < 9 || name.substr(name.size()-8) != ".desktop") continue;
-      std::string lower_name = name;
-      std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(), ::tolower);
-      if (lower_name.find(lower_id) != std::string::npos) {
-        auto icon = icon_from_desktop_file(dir + "/" + name);
-        closedir(d);
-        if (!icon.empty()) return icon;
+struct icon_index_t {
+  // Desktop id, lowercase id and StartupWMClass (both cases) → Icon=, first dir wins
+  std::unordered_map<std::string, std::string> desktop_icons;
+  // Lowercase desktop ids in scan order, for the substring fallback
+  std::vector<std::pair<std::string, std::string>> desktop_lower;
+  // Icon name → PNG path, in the same theme/size priority as the old path probing
+  std::unordered_map<std::string, std::string> icon_paths;
+  // Every existing directory the index was built from, for inotify
+  std::vector<std::string> dirs;
+
+  // Blocking filesystem scan; run it on a worker
+  static std::shared_ptr<icon_index_t> build() {
+    auto idx = std::make_shared<icon_index_t>();
+    auto add_dir = [&](const std::string &d) { if (file_exists(d)) { idx->dirs.push_back(d); return true; } return false; };
+    for (auto &dir : application_dirs()) {
+      if (!add_dir(dir)) continue;
+      for_each_file(dir, ".desktop", [&](const std::string &id) {
+        std::string icon, wm_class;
+        parse_desktop_entry(dir + "/" + id + ".desktop", icon, wm_class);
+        if (icon.empty()) return;
+        auto lower = to_lower(id);
+        idx->desktop_icons.emplace(id, icon); idx->desktop_icons.emplace(lower, icon);
+        if (!wm_class.empty()) { idx->desktop_icons.emplace(wm_class, icon); idx->desktop_icons.emplace(to_lower(wm_class), icon); }
+        idx->desktop_lower.emplace_back(lower, icon);
+      });
+    }
+    static const char *sizes[] = {"256x256","128x128","96x96","64x64","48x48","32x32","scalable"};
+    static const char *themes[] = {"hicolor","Adwaita","breeze","gnome","Papirus"};
+    static const char *bases[] = {"/usr/share/icons", "/usr/local/share/icons"};
+    static const char *subs[] = {"apps", "mimetypes", "categories", "places"};
+    for (auto base : bases) {
+      if (!add_dir(base)) continue;
+      for (auto theme : themes) {
+        std::string td = std::string(base) + "/" + theme;
+        if (!add_dir(td)) continue;
+        for (auto sz : sizes) for (auto sub : subs) {
+          std::string dir = td + "/" + sz + "/" + sub;
+          if (!add_dir(dir)) continue;
+          for_each_file(dir, ".png", [&](const std::string &name) { idx->icon_paths.emplace(name, dir + "/" + name + ".png"); });
+        }
       }
     }
-    closedir(d);
+    if (add_dir("/usr/share/pixmaps"))
+      for_each_file("/usr/share/pixmaps", ".png", [&](const std::string &name) { idx->icon_paths.emplace(name, "/usr/share/pixmaps/" + name + ".png"); });
+    return idx;
+  }
+
+  std::string icon_path(const std::string &icon_name) const {
+    if (icon_name.empty()) return "";
+    if (icon_name[0] == '/') return icon_name;
+    auto it = icon_paths.find(icon_name);
+    return it != icon_paths.end() ? it->second : "";
+  }
+
+  std::string desktop_icon(const std::string &app_id, const std::string &lower_id) const {
+    for (auto &k : {app_id, lower_id}) { auto it = desktop_icons.find(k); if (it != desktop_icons.end()) return it->second; }
+    for (auto &[name, icon] : desktop_lower) if (name.find(lower_id) != std::string::npos) return icon;
+    return "";
+  }
+
+  // Same candidate order as before: the id itself, lowercase, the desktop entry's
+  // Icon=, then dotted/dashed variants
+  std::string find_app_icon_path(const std::string &app_id) const {
+    auto lower = to_lower(app_id);
+    std::string p;
+    if (!(p = icon_path(app_id)).empty() || !(p = icon_path(lower)).empty()) return p;
+    if (!(p = icon_path(desktop_icon(app_id, lower))).empty()) return p;
+    std::string dashed = app_id, dotted = app_id;
+    std::replace(dashed.begin(), dashed.end(), '.', '-'); std::replace(dotted.begin(), dotted.end(), '-', '.');
+    if (!(p = icon_path(dashed)).empty() || !(p = icon_path(dotted)).empty()) return p;
+    return "";
   }
-  return "";
+};
+
+// Scales src into a new target_size x target_size surface, preserving aspect ratio
+static cairo_surface_t *scale_icon_surface(cairo_surface_t *src, int target_size) {
+  int sw = cairo_image_surface_get_width(src);
+  int sh = cairo_image_surface_get_height(src);
+  auto scaled = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, target_size, target_size);
+  auto cr = cairo_create(scaled);
+  double sc = (double)target_size / std::max(sw, sh);
+  double ox = (target_size - sw * sc) / 2.0;
+  double oy = (target_size - sh * sc) / 2.0;
+  cairo_translate(cr, ox, oy);
+  cairo_scale(cr, sc, sc);
+  cairo_set_source_surface(cr, src, 0, 0);
+  cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_BILINEAR);
+  cairo_paint(cr);
+  cairo_destroy(cr);
+  cairo_surface_flush(scaled);
+  return scaled;
 }
 
-struct icon_tex_t {
-  GLuint tex_id = 0;
-  int width = 0, height = 0;
+// Only touches the filesystem and a cairo image surface, so it is safe on a worker.
+// Returns the scaled icon or nullptr.
+static cairo_surface_t *try_load_png(const std::string &path, int target_size) {
+  if (!file_exists(path)) return nullptr;
+  auto surf = cairo_image_surface_create_from_png(path.c_str());
+  if (cairo_surface_status(surf) != CAIRO_STATUS_SUCCESS) { cairo_surface_destroy(surf); return nullptr; }
+  auto scaled = scale_icon_surface(surf, target_size);
+  cairo_surface_destroy(surf);
+  return scaled;
+}
 
-  void upload_surface(cairo_surface_t *src, int target_size) {
-    int sw = cairo_image_surface_get_width(src);
-    int sh = cairo_image_surface_get_height(src);
-    width = height = target_size;
-    auto scaled = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-    auto cr = cairo_create(scaled);
-    double sc = (double)target_size / std::max(sw, sh);
-    double ox = (target_size - sw * sc) / 2.0;
-    double oy = (target_size - sh * sc) / 2.0;
-    cairo_translate(cr, ox, oy);
-    cairo_scale(cr, sc, sc);
-    cairo_set_source_surface(cr, src, 0, 0);
-    cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_BILINEAR);
-    cairo_paint(cr);
-    cairo_destroy(cr);
-    cairo_surface_flush(scaled);
-    auto data = cairo_image_surface_get_data(scaled);
-    glGenTextures(1, &tex_id);
-    glBindTexture(GL_TEXTURE_2D, tex_id);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, data);
+// ============================================================================
+// Icon Atlas — icons of one pixel size share fixed-size cells of a few textures
+// ============================================================================
+
+class icon_atlas_t {
+  static constexpr int PAGE_SIZE = 1024;
+  // Each cell keeps a 1px transparent border so linear filtering never bleeds
+  struct page_t { GLuint tex = 0; int cell = 0, cols = 0; std::vector<int> free_cells; };
+  std::vector<page_t> pages;
+
+public:
+  struct slot_t { int page = -1, cell = -1; GLuint tex = 0; glm::vec4 uv{0, 0, 1, 1}; };
+
+  size_t gpu_bytes() const { return pages.size() * PAGE_SIZE * PAGE_SIZE * 4; }
+
+  // Copies a px x px BGRA image into a free cell; needs the GL context
+  slot_t upload(const unsigned char *data, int stride, int px) {
+    int cell = std::min(px + 2, PAGE_SIZE);
+    int pi = -1;
+    for (int i = 0; i < (int)pages.size(); i++) if (pages[i].cell == cell && !pages[i].free_cells.empty()) { pi = i; break; }
+    if (pi < 0) {
+      page_t pg; pg.cell = cell; pg.cols = PAGE_SIZE / cell;
+      for (int c = pg.cols * pg.cols - 1; c >= 0; c--) pg.free_cells.push_back(c);
+      std::vector<unsigned char> zero((size_t)PAGE_SIZE * PAGE_SIZE * 4, 0);
+      glGenTextures(1, &pg.tex);
+      glBindTexture(GL_TEXTURE_2D, pg.tex);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PAGE_SIZE, PAGE_SIZE, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, zero.data());
+      pages.push_back(std::move(pg)); pi = (int)pages.size() - 1;
+    }
+    auto &pg = pages[pi];
+    int ci = pg.free_cells.back(); pg.free_cells.pop_back();
+    int cx = (ci % pg.cols) * cell, cy = (ci / pg.cols) * cell, n = cell - 2;
+    std::vector<unsigned char> padded((size_t)cell * cell * 4, 0);
+    for (int y = 0; y < std::min(px, n); y++)
+      std::copy(data + y * stride, data + y * stride + std::min(px, n) * 4, padded.begin() + ((y + 1) * cell + 1) * 4);
+    glBindTexture(GL_TEXTURE_2D, pg.tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, cx, cy, cell, cell, GL_BGRA_EXT, GL_UNSIGNED_BYTE, padded.data());
     glBindTexture(GL_TEXTURE_2D, 0);
-    cairo_surface_destroy(scaled);
+    float inv = 1.0f / PAGE_SIZE;
+    return {pi, ci, pg.tex, {(cx + 1) * inv, (cy + 1) * inv, (cx + 1 + n) * inv, (cy + 1 + n) * inv}};
   }
 
-  bool try_load_png(const std::string &path, int target_size) {
-    if (!file_exists(path)) return false;
-    auto surf = cairo_image_surface_create_from_png(path.c_str());
-    if (cairo_surface_status(surf) != CAIRO_STATUS_SUCCESS) { cairo_surface_destroy(surf); return false; }
-    upload_surface(surf, target_size);
-    cairo_surface_destroy(surf);
-    return true;
+  void release(slot_t &s) {
+    if (s.page >= 0 && s.page < (int)pages.size()) pages[s.page].free_cells.push_back(s.cell);
+    s = {};
   }
 
-  bool load_icon_by_name(const std::string &icon_name, int target_size) {
-    if (icon_name.empty()) return false;
-    if (icon_name[0] == '/') return try_load_png(icon_name, target_size);
-    static const char *sizes[] = {"256x256","128x128","96x96","64x64","48x48","32x32","scalable"};
-    static const char *themes[] = {"hicolor","Adwaita","breeze","gnome","Papirus"};
-    static const char *bases[] = {"/usr/share/icons", "/usr/local/share/icons"};
-    for (auto base : bases) for (auto theme : themes) for (auto sz : sizes) {
-      std::string cat = (std::string(sz) == "scalable") ? "scalable" : sz;
-      std::string path = std::string(base) + "/" + theme + "/" + cat + "/apps/" + icon_name + ".png";
-      if (try_load_png(path, target_size)) return true;
-      for (auto sub : {"apps", "mimetypes", "categories", "places"}) {
-        path = std::string(base) + "/" + theme + "/" + cat + "/" + sub + "/" + icon_name + ".png";
-        if (try_load_png(path, target_size)) return true;
-      }
-    }
-    std::string pixmap = "/usr/share/pixmaps/" + icon_name + ".png";
-    return try_load_png(pixmap, target_size);
-  }
-
-  bool load_for_app(const std::string &app_id, int target_size) {
-    if (load_icon_by_name(app_id, target_size)) return true;
-    std::string lower = app_id;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    if (lower != app_id && load_icon_by_name(lower, target_size)) return true;
-    std::string icon_name = find_icon_name_for_app(app_id);
-    if (!icon_name.empty() && load_icon_by_name(icon_name, target_size)) return true;
-    std::string alt = app_id;
-    for (auto &c : alt) { if (c == '.') c = '-'; }
-    if (alt != app_id && load_icon_by_name(alt, target_size)) return true;
-    alt = app_id; for (auto &c : alt) { if (c == '-') c = '.'; }
-    if (alt != app_id && load_icon_by_name(alt, target_size)) return true;
-    return false;
+  void clear() { for (auto &pg : pages) glDeleteTextures(1, &pg.tex); pages.clear(); }
+};
+
+struct icon_tex_t {
+  icon_atlas_t *atlas = nullptr;
+  icon_atlas_t::slot_t slot;
+  GLuint tex_id = 0;  // the atlas page holding this icon, slot.uv is its cell
+  int width = 0, height = 0;
+  bool is_fallback = false;
+
+  // Uploads a surface produced by scale_icon_surface; needs the GL context
+  void upload_surface(cairo_surface_t *scaled) {
+    width = cairo_image_surface_get_width(scaled);
+    height = cairo_image_surface_get_height(scaled);
+    upload(cairo_image_surface_get_data(scaled), cairo_image_surface_get_stride(scaled));
+    is_fallback = false;
+  }
+
+  void upload(const unsigned char *data, int stride) {
+    slot = atlas->upload(data, stride, width);
+    tex_id = slot.tex;
   }
 
   void create_fallback(const std::string &app_name, int target_size) {
@@ -263,17 +431,279 @@ struct icon_tex_t {
       pango_font_description_free(fd); g_object_unref(layout);
     }
     cairo_surface_flush(surface);
-    auto data = cairo_image_surface_get_data(surface);
-    glGenTextures(1, &tex_id);
-    glBindTexture(GL_TEXTURE_2D, tex_id);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, data);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    upload(cairo_image_surface_get_data(surface), cairo_image_surface_get_stride(surface));
     cairo_destroy(cr); cairo_surface_destroy(surface);
+    is_fallback = true;
+  }
+
+  void destroy() { if (tex_id) { atlas->release(slot); tex_id = 0; } width = height = 0; }
+};
+
+// ============================================================================
+// Worker Pool — runs blocking work off the compositor thread
+// ============================================================================
+
+class worker_pool_t {
+  std::vector<std::thread> threads;
+  std::mutex mutex; std::condition_variable cv;
+  std::deque<std::function<void()>> jobs;     // run on a worker
+  std::deque<std::function<void()>> finished; // run on the compositor thread
+  int event_fd = -1; wl_event_source *source = nullptr; bool stopping = false;
+
+  static int on_event(int fd, uint32_t, void *data) {
+    uint64_t n; if (read(fd, &n, sizeof(n)) < 0) {}
+    ((worker_pool_t*)data)->run_finished();
+    return 0;
+  }
+  void run_finished() {
+    std::deque<std::function<void()>> batch;
+    { std::lock_guard<std::mutex> lk(mutex); batch.swap(finished); }
+    for (auto &f : batch) f();
+  }
+  void worker_loop() {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lk(mutex);
+        cv.wait(lk, [&] { return stopping || !jobs.empty(); });
+        if (stopping) return;
+        job = std::move(jobs.front()); jobs.pop_front();
+      }
+      job();
+    }
+  }
+
+public:
+  void start(int n) {
+    if (!threads.empty()) return;
+    event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    source = wl_event_loop_add_fd(wf::get_core().ev_loop, event_fd, WL_EVENT_READABLE, on_event, this);
+    stopping = false;
+    for (int i = 0; i < n; i++) threads.emplace_back([this] { worker_loop(); });
+  }
+  // Pending jobs and completions are dropped; callers must not rely on them afterwards
+  void stop() {
+    { std::lock_guard<std::mutex> lk(mutex); stopping = true; jobs.clear(); }
+    cv.notify_all();
+    for (auto &t : threads) t.join();
+    threads.clear(); finished.clear();
+    if (source) { wl_event_source_remove(source); source = nullptr; }
+    if (event_fd >= 0) { close(event_fd); event_fd = -1; }
+  }
+  ~worker_pool_t() { stop(); }
+
+  // Runs work on a worker thread, then finish on the compositor thread
+  void submit(std::function<void()> work, std::function<void()> finish) {
+    if (threads.empty()) { work(); finish(); return; }
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      jobs.push_back([this, work = std::move(work), finish = std::move(finish)]() mutable {
+        work();
+        { std::lock_guard<std::mutex> lk(mutex); finished.push_back(std::move(finish)); }
+        uint64_t one = 1; if (write(event_fd, &one, sizeof(one)) < 0) {}
+      });
+    }
+    cv.notify_one();
+  }
+};
+
+// ============================================================================
+// Icon Cache — one texture per (app_id, size, scale), shared by all outputs
+// ============================================================================
+
+class icon_cache_t {
+  struct key_t {
+    std::string app_id; int size; float scale;
+    bool operator<(const key_t &o) const { return std::tie(app_id, size, scale) < std::tie(o.app_id, o.size, o.scale); }
+  };
+  std::map<key_t, std::shared_ptr<icon_tex_t>> entries;
+  icon_atlas_t atlas;
+  // Unreferenced icons kept around across overview toggles before trimming
+  static constexpr size_t MAX_ENTRIES = 256;
+
+  std::shared_ptr<const icon_index_t> index;
+  struct pending_t { std::shared_ptr<icon_tex_t> icon; std::string app_id, app_name; int px; };
+  std::vector<pending_t> pending;  // lookups waiting for the first index build
+  int inotify_fd = -1; wl_event_source *inotify_source = nullptr;
+  std::vector<int> watches;
+  wf::wl_timer<false> rebuild_timer;
+
+  // Resolves and decodes app_id's icon on a worker, then swaps it into icon.
+  // Until then (or if no icon is found) icon keeps showing the fallback.
+  void resolve(std::shared_ptr<icon_tex_t> icon, const std::string &app_id, const std::string &app_name, int px) {
+    if (!index) { pending.push_back({icon, app_id, app_name, px}); return; }
+    struct decoded_t { cairo_surface_t *surf = nullptr; ~decoded_t() { if (surf) cairo_surface_destroy(surf); } };
+    auto d = std::make_shared<decoded_t>();
+    pool->submit([d, idx = index, app_id, px] { d->surf = try_load_png(idx->find_app_icon_path(app_id), px); },
+      [this, d, icon, app_name, px] {
+        if (!d->surf && icon->is_fallback) return;
+        wf::gles::run_in_context([&] {
+          icon->destroy();
+          if (d->surf) icon->upload_surface(d->surf); else icon->create_fallback(app_name, px);
+        });
+        if (on_icon_loaded) on_icon_loaded(icon.get());
+      });
+  }
+
+public:
+  worker_pool_t *pool = nullptr;
+  // Called on the compositor thread whenever an icon texture was replaced
+  std::function<void(const icon_tex_t*)> on_icon_loaded;
+
+  size_t gpu_bytes() const { return atlas.gpu_bytes(); }
+
+  // Must be called with the GL context current. Returns immediately with the fallback
+  // icon; the real one is swapped in once a worker has found and decoded it. Failed
+  // lookups stay cached as the fallback, so the same app never hits the disk twice.
+  std::shared_ptr<icon_tex_t> get(const std::string &app_id, const std::string &app_name, int size, float scale) {
+    key_t key{app_id.empty() ? "name:" + app_name : app_id, size, scale};
+    auto it = entries.find(key);
+    if (it != entries.end()) return it->second;
+    if (entries.size() >= MAX_ENTRIES) trim();
+    int px = (int)std::round(size * scale);
+    auto icon = std::make_shared<icon_tex_t>();
+    icon->atlas = &atlas;
+    icon->create_fallback(app_name, px);
+    entries.emplace(key, icon);
+    if (!app_id.empty()) resolve(icon, app_id, app_name, px);
+    return icon;
+  }
+
+  // Drops icons no slot references anymore
+  void trim() {
+    for (auto it = entries.begin(); it != entries.end();) {
+      if (it->second.use_count() == 1) { it->second->destroy(); it = entries.erase(it); } else ++it;
+    }
+  }
+
+  // Re-resolves every icon in place, for when desktop files or icon themes changed.
+  // The current textures stay visible until the new lookups complete.
+  void invalidate() {
+    trim();
+    for (auto &[k, icon] : entries)
+      if (k.app_id.rfind("name:", 0) != 0) resolve(icon, k.app_id, k.app_id, (int)std::round(k.size * k.scale));
+  }
+
+  void clear() { for (auto &[k, icon] : entries) icon->destroy(); entries.clear(); atlas.clear(); }
+
+  // Scans desktop entries and icon themes on a worker. The first build flushes the
+  // lookups queued so far, later ones re-resolve every cached icon.
+  void rebuild_index() {
+    auto built = std::make_shared<std::shared_ptr<icon_index_t>>();
+    pool->submit([built] { *built = icon_index_t::build(); }, [this, built] {
+      bool first = !index; index = *built;
+      update_watches();
+      if (first) { auto p = std::move(pending); pending.clear(); for (auto &e : p) resolve(e.icon, e.app_id, e.app_name, e.px); }
+      else wf::gles::run_in_context([&] { invalidate(); });
+    });
+  }
+
+  // Watches application and icon directories; changes are debounced into one rebuild
+  void start() {
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd >= 0) {
+      inotify_source = wl_event_loop_add_fd(wf::get_core().ev_loop, inotify_fd, WL_EVENT_READABLE, [](int fd, uint32_t, void *data) {
+        char buf[4096]; while (read(fd, buf, sizeof(buf)) > 0) {}
+        auto self = (icon_cache_t*)data;
+        if (!self->rebuild_timer.is_connected()) self->rebuild_timer.set_timeout(1000, [self]() { self->rebuild_index(); });
+        return 0;
+      }, this);
+    }
+    rebuild_index();
+  }
+
+  void stop() {
+    rebuild_timer.disconnect();
+    if (inotify_source) { wl_event_source_remove(inotify_source); inotify_source = nullptr; }
+    if (inotify_fd >= 0) { close(inotify_fd); inotify_fd = -1; }
+    watches.clear(); pending.clear();
+  }
+
+private:
+  void update_watches() {
+    if (inotify_fd < 0) return;
+    for (int wd : watches) inotify_rm_watch(inotify_fd, wd);
+    watches.clear();
+    for (auto &dir : index->dirs) {
+      int wd = inotify_add_watch(inotify_fd, dir.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE);
+      if (wd >= 0) watches.push_back(wd);
+    }
+  }
+};
+
+// ============================================================================
+// Wallpaper — decoded once on a worker, shared by all outputs
+// ============================================================================
+
+// Decodes path and scales it down, keeping the aspect ratio, until it just covers
+// max_w x max_h. Never scales up. Worker-safe; returns nullptr on failure.
+static cairo_surface_t *load_wallpaper_surface(const std::string &path, int max_w, int max_h) {
+  if (!file_exists(path)) return nullptr;
+  auto img = cairo_image_surface_create_from_png(path.c_str());
+  if (cairo_surface_status(img) != CAIRO_STATUS_SUCCESS) { cairo_surface_destroy(img); return nullptr; }
+  int w = cairo_image_surface_get_width(img), h = cairo_image_surface_get_height(img);
+  double sc = std::min(1.0, std::max((double)max_w / w, (double)max_h / h));
+  if (sc >= 1.0 || max_w <= 0 || max_h <= 0) return img;
+  int tw = std::max(1, (int)std::ceil(w * sc)), th = std::max(1, (int)std::ceil(h * sc));
+  auto scaled = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, tw, th);
+  auto cr = cairo_create(scaled);
+  cairo_scale(cr, (double)tw / w, (double)th / h);
+  cairo_set_source_surface(cr, img, 0, 0);
+  cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+  cairo_paint(cr);
+  cairo_destroy(cr); cairo_surface_destroy(img);
+  cairo_surface_flush(scaled);
+  return scaled;
+}
+
+struct wallpaper_tex_t {
+  GLuint tex_id = 0; int width = 0, height = 0;
+  size_t bytes() const { return (size_t)width * height * 4; }
+  ~wallpaper_tex_t() { if (tex_id) wf::gles::run_in_context_if_gles([&] { glDeleteTextures(1, &tex_id); }); }
+};
+
+class wallpaper_loader_t {
+  std::shared_ptr<wallpaper_tex_t> current;
+  std::string path; int max_w = 0, max_h = 0;
+  uint64_t generation = 0;  // bumped per request, so a slow stale decode never wins
+
+public:
+  worker_pool_t *pool = nullptr;
+  // Called on the compositor thread once a new wallpaper replaced the old one
+  std::function<void()> on_loaded;
+
+  std::shared_ptr<wallpaper_tex_t> get() const { return current; }
+
+  // (Re)loads p sized for the largest output. The previous wallpaper stays in use until
+  // the new one is ready; an unchanged request that already covers the size is a no-op.
+  void load(const std::string &p, int w, int h) {
+    if (p == path && w <= max_w && h <= max_h && (current || generation)) return;
+    if (p != path) { max_w = w; max_h = h; } else { max_w = std::max(w, max_w); max_h = std::max(h, max_h); }
+    path = p;
+    uint64_t gen = ++generation;
+    if (path.empty()) { current = nullptr; if (on_loaded) on_loaded(); return; }
+    struct decoded_t { cairo_surface_t *surf = nullptr; ~decoded_t() { if (surf) cairo_surface_destroy(surf); } };
+    auto d = std::make_shared<decoded_t>();
+    pool->submit([d, p, mw = max_w, mh = max_h] { d->surf = load_wallpaper_surface(p, mw, mh); },
+      [this, d, gen] {
+        if (gen != generation) return;
+        if (!d->surf) { LOGE("overview: cannot load wallpaper ", path); return; }
+        auto t = std::make_shared<wallpaper_tex_t>();
+        t->width = cairo_image_surface_get_width(d->surf); t->height = cairo_image_surface_get_height(d->surf);
+        wf::gles::run_in_context([&] {
+          glGenTextures(1, &t->tex_id);
+          glBindTexture(GL_TEXTURE_2D, t->tex_id);
+          glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+          glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+          glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, t->width, t->height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, cairo_image_surface_get_data(d->surf));
+          glBindTexture(GL_TEXTURE_2D, 0);
+        });
+        current = std::move(t);
+        if (on_loaded) on_loaded();
+      });
   }
 
-  void destroy() { if (tex_id) { glDeleteTextures(1, &tex_id); tex_id = 0; } width = height = 0; }
+  void clear() { current = nullptr; path.clear(); max_w = max_h = 0; generation++; }
 };
 
 // ============================================================================
@@ -286,23 +716,37 @@ struct window_slot_t {
   anim_geo_t anim;
   std::shared_ptr<wf::scene::view_2d_transformer_t> transformer;
   bool hovered = false;
-  icon_tex_t icon;
+  bool dragged = false;  // drawn as the floating drag thumbnail instead
+  std::shared_ptr<icon_tex_t> icon;
   std::string app_id, app_name;
 
+  // A dragged window stays (invisibly) in its workspace capture rather than at alpha 0,
+  // so it keeps being rendered and the client keeps getting frame callbacks
+  static constexpr float DRAG_HIDDEN_ALPHA = 0.001f;
+
+  explicit window_slot_t(anim_engine_t &e) : anim(e) {}
+
   void start_anim(bool entering, float duration) {
     anim.set_duration(duration);
     if (entering) { anim.warp(orig_geo); anim.animate_to(target_geo); }
     else { anim.animate_to(orig_geo); }
   }
-  void update_transformer() {
-    if (!transformer || !view || !view->is_mapped() || orig_geo.width <= 0 || orig_geo.height <= 0) return;
+  // Returns whether the transform changed. The view is damaged before and after a change
+  // so the old and new spots are both repainted; a settled slot costs nothing.
+  bool update_transformer() {
+    if (!transformer || !view || !view->is_mapped() || orig_geo.width <= 0 || orig_geo.height <= 0) return false;
     auto cur = anim.current();
     float sx = std::clamp((float)cur.width / orig_geo.width, 0.1f, 10.0f);
     float sy = std::clamp((float)cur.height / orig_geo.height, 0.1f, 10.0f);
-    transformer->translation_x = (cur.x + cur.width/2.0f) - (orig_geo.x + orig_geo.width/2.0f);
-    transformer->translation_y = (cur.y + cur.height/2.0f) - (orig_geo.y + orig_geo.height/2.0f);
-    transformer->scale_x = sx; transformer->scale_y = sy;
-    transformer->alpha = hovered ? 1.0f : 0.88f;
+    float tx = (cur.x + cur.width/2.0f) - (orig_geo.x + orig_geo.width/2.0f);
+    float ty = (cur.y + cur.height/2.0f) - (orig_geo.y + orig_geo.height/2.0f);
+    float a = dragged ? DRAG_HIDDEN_ALPHA : hovered ? 1.0f : 0.88f;
+    auto &t = *transformer;
+    if (t.translation_x == tx && t.translation_y == ty && t.scale_x == sx && t.scale_y == sy && t.alpha == a) return false;
+    view->damage();
+    t.translation_x = tx; t.translation_y = ty; t.scale_x = sx; t.scale_y = sy; t.alpha = a;
+    view->damage();
+    return true;
   }
   void reset_transformer() {
     if (!transformer) return;
@@ -327,62 +771,133 @@ class top_panel_t {
 public:
   wf::output_t *output;
   cairo_surface_t *surface = nullptr; cairo_t *cr = nullptr;
+  PangoLayout *layout = nullptr; PangoFontDescription *font = nullptr;
   GLuint tex_id = 0; int width = 0, height = 16;
-  wf::geometry_t activities_bounds{}; bool activities_hovered = false;
+  wf::geometry_t activities_bounds{}, clock_bounds{}; bool activities_hovered = false;
   std::string color = "#1a1a1aE6";
+  float bg[4] = {0.1f, 0.1f, 0.1f, 0.9f};
+  std::string clock_text;
+  // Surface area repainted since the last upload, in panel pixels
+  wf::geometry_t dirty{};
 
   top_panel_t(wf::output_t *out, int h, const std::string &c) : output(out), height(h), color(c) { create(); }
   ~top_panel_t() { destroy(); }
 
   void create() {
     width = output->get_layout_geometry().width;
+    if (color.length() >= 7 && color[0] == '#') {
+      bg[0] = std::stoi(color.substr(1,2), nullptr, 16) / 255.0f;
+      bg[1] = std::stoi(color.substr(3,2), nullptr, 16) / 255.0f;
+      bg[2] = std::stoi(color.substr(5,2), nullptr, 16) / 255.0f;
+      if (color.length() >= 9) bg[3] = std::stoi(color.substr(7,2), nullptr, 16) / 255.0f;
+    }
     surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-    cr = cairo_create(surface); render(); upload();
+    cr = cairo_create(surface);
+    layout = pango_cairo_create_layout(cr);
+    int fs = height >= 24 ? 11 : 8; char fd[32]; snprintf(fd, sizeof(fd), "Sans Bold %d", fs);
+    font = pango_font_description_from_string(fd);
+    pango_layout_set_font_description(layout, font);
+    render(); upload();
   }
   void destroy() {
     if (tex_id) { wf::gles::run_in_context([&] { glDeleteTextures(1, &tex_id); }); tex_id = 0; }
+    if (font) { pango_font_description_free(font); font = nullptr; }
+    if (layout) { g_object_unref(layout); layout = nullptr; }
     if (cr) { cairo_destroy(cr); cr = nullptr; }
     if (surface) { cairo_surface_destroy(surface); surface = nullptr; }
   }
-  void render() {
-    if (!cr) return;
-    float r = 0.1f, g = 0.1f, b = 0.1f, a = 0.9f;
-    if (color.length() >= 7 && color[0] == '#') {
-      r = std::stoi(color.substr(1,2), nullptr, 16) / 255.0f;
-      g = std::stoi(color.substr(3,2), nullptr, 16) / 255.0f;
-      b = std::stoi(color.substr(5,2), nullptr, 16) / 255.0f;
-      if (color.length() >= 9) a = std::stoi(color.substr(7,2), nullptr, 16) / 255.0f;
-    }
-    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE); cairo_set_source_rgba(cr, r, g, b, a); cairo_paint(cr);
-    PangoLayout *layout = pango_cairo_create_layout(cr);
-    int fs = height >= 24 ? 11 : 8; char font[32]; snprintf(font, sizeof(font), "Sans Bold %d", fs);
-    PangoFontDescription *fd = pango_font_description_from_string(font);
-    pango_layout_set_font_description(layout, fd);
+
+  void mark_dirty(wf::geometry_t r) {
+    r = wf::geometry_intersection(r, {0, 0, width, height});
+    if (r.width <= 0 || r.height <= 0) return;
+    if (dirty.width <= 0) { dirty = r; return; }
+    int x0 = std::min(dirty.x, r.x), y0 = std::min(dirty.y, r.y);
+    int x1 = std::max(dirty.x + dirty.width, r.x + r.width), y1 = std::max(dirty.y + dirty.height, r.y + r.height);
+    dirty = {x0, y0, x1 - x0, y1 - y0};
+  }
+
+  // Repaints the background of r only
+  void clear_rect(wf::geometry_t r) {
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE); cairo_set_source_rgba(cr, bg[0], bg[1], bg[2], bg[3]);
+    cairo_rectangle(cr, r.x, r.y, r.width, r.height); cairo_fill(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+  }
+
+  void draw_activities() {
     pango_layout_set_text(layout, "Activities", -1);
     int tw, th; pango_layout_get_pixel_size(layout, &tw, &th);
     int ax = 8, ay = (height - th) / 2;
     activities_bounds = {ax - 4, 0, tw + 8, height};
+    clear_rect(activities_bounds);
     if (activities_hovered) { cairo_set_source_rgba(cr, 1, 1, 1, 0.15); cairo_rectangle(cr, activities_bounds.x, 0, activities_bounds.width, height); cairo_fill(cr); }
     cairo_set_source_rgba(cr, 1, 1, 1, 1); cairo_move_to(cr, ax, ay); pango_cairo_show_layout(cr, layout);
+    mark_dirty(activities_bounds);
+  }
+
+  void draw_clock() {
+    pango_layout_set_text(layout, clock_text.c_str(), -1);
+    int tw, th; pango_layout_get_pixel_size(layout, &tw, &th);
+    auto old = clock_bounds;
+    clock_bounds = {(width - tw) / 2, 0, tw, height};
+    clear_rect(old); clear_rect(clock_bounds);
+    cairo_set_source_rgba(cr, 1, 1, 1, 1); cairo_move_to(cr, clock_bounds.x, (height - th) / 2); pango_cairo_show_layout(cr, layout);
+    mark_dirty(old); mark_dirty(clock_bounds);
+  }
+
+  // Full repaint, only needed once after creation
+  void render() {
+    if (!cr) return;
+    clear_rect({0, 0, width, height});
+    clock_text = current_clock_text();
+    draw_activities(); draw_clock();
+    mark_dirty({0, 0, width, height});
+  }
+
+  static std::string current_clock_text() {
     time_t now = time(nullptr); char ts[64]; strftime(ts, sizeof(ts), "%a %b %d  %H:%M", localtime(&now));
-    pango_layout_set_text(layout, ts, -1); pango_layout_get_pixel_size(layout, &tw, &th);
-    cairo_move_to(cr, (width - tw) / 2, (height - th) / 2); pango_cairo_show_layout(cr, layout);
-    pango_font_description_free(fd); g_object_unref(layout); cairo_surface_flush(surface);
+    return ts;
+  }
+
+  // Redraws the clock if the displayed minute changed; returns whether it did
+  bool update_clock() {
+    auto t = current_clock_text();
+    if (!cr || t == clock_text) return false;
+    clock_text = t; draw_clock(); return true;
   }
+
+  // Uploads the dirty part of the surface. The texture is allocated once; later
+  // uploads copy just the dirty rows/columns into a packed buffer for glTexSubImage2D.
   void upload() {
-    if (!surface) return; unsigned char *data = cairo_image_surface_get_data(surface);
+    if (!surface || dirty.width <= 0) return;
+    cairo_surface_flush(surface);
+    unsigned char *data = cairo_image_surface_get_data(surface);
+    int stride = cairo_image_surface_get_stride(surface);
     wf::gles::run_in_context([&] {
-      if (!tex_id) glGenTextures(1, &tex_id);
+      bool fresh = !tex_id;
+      if (fresh) glGenTextures(1, &tex_id);
       glBindTexture(GL_TEXTURE_2D, tex_id);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, data);
+      if (fresh) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, data);
+      } else {
+        std::vector<unsigned char> sub((size_t)dirty.width * dirty.height * 4);
+        for (int y = 0; y < dirty.height; y++) {
+          auto row = data + (dirty.y + y) * stride + dirty.x * 4;
+          std::copy(row, row + dirty.width * 4, sub.begin() + (size_t)y * dirty.width * 4);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, dirty.x, dirty.y, dirty.width, dirty.height, GL_BGRA_EXT, GL_UNSIGNED_BYTE, sub.data());
+      }
       glBindTexture(GL_TEXTURE_2D, 0);
     });
+    dirty = {};
   }
   wf::geometry_t get_geometry() const { auto og = output->get_layout_geometry(); return {og.x, og.y, width, height}; }
   wf::geometry_t get_render_geometry() const { auto og = output->get_layout_geometry(); return {og.x, og.y + og.height - height, width, height}; }
-  bool set_hover(bool h) { if (activities_hovered == h) return false; activities_hovered = h; render(); upload(); return true; }
+  // Output-layout rect of a panel-local rect, for damaging only what was redrawn
+  wf::geometry_t to_layout(wf::geometry_t r) const { auto og = output->get_layout_geometry(); return {og.x + r.x, og.y + r.y, r.width, r.height}; }
+  bool set_hover(bool h) { if (activities_hovered == h) return false; activities_hovered = h; draw_activities(); upload(); return true; }
   bool point_in_activities(wf::pointf_t p) const {
     auto og = output->get_layout_geometry(); int lx = p.x - og.x, ly = p.y - og.y;
     return lx >= activities_bounds.x && lx < activities_bounds.x + activities_bounds.width && ly >= 0 && ly < height;
@@ -397,10 +912,9 @@ struct drag_state_t {
   bool active = false; wayfire_toplevel_view view = nullptr; int slot_index = -1;
   wf::pointf_t grab_cursor{0, 0}, current_cursor{0, 0};
   wf::geometry_t initial_screen_geo{}; int hover_ws = -1; int hover_large_ws = -1;
-  wf::auxilliary_buffer_t snapshot_fb; bool has_snapshot = false, needs_capture = false;
   int float_width = 0, float_height = 0; wf::geometry_t view_geo{};
   wf::pointf_t grab_offset_in_window{0, 0};
-  void reset() { active = false; view = nullptr; slot_index = -1; hover_ws = -1; hover_large_ws = -1; has_snapshot = false; needs_capture = false; }
+  void reset() { active = false; view = nullptr; slot_index = -1; hover_ws = -1; hover_large_ws = -1; }
 };
 
 // ============================================================================
@@ -410,10 +924,14 @@ struct drag_state_t {
 class activities_view_t {
 public:
   wf::output_t *output;
+  anim_engine_t anims;  // declared first so every handle below is released before it
 
   struct ws_window_data_t {
     std::vector<window_slot_t> slots;
     bool transformers_attached = false;
+    // Last layout, keyed by the slots' original geometries and the area it was made for
+    std::vector<wf::geometry_t> layout_orig, layout_target;
+    wf::dimensions_t layout_area{0, 0}; int layout_spacing = -1;
   };
   std::vector<ws_window_data_t> ws_windows;
 
@@ -432,12 +950,20 @@ public:
   anim_geo_t desktop_anim;
 
   bool is_active = false, is_animating = false;
+  std::vector<int> relayout_ws;  // workspaces whose slots are moving after a live update
+  bool exiting = false;      // deactivate() ran, waiting for the zoom-in to finish
+  bool moving_view = false;  // our own view->move(), not a geometry change to react to
   bool switching_ws = false; int pending_ws = -1;
   int corner_radius = 12, spacing = 20, panel_height = 16, anim_duration = 300;
   int icon_size = 72;
+  icon_cache_t *icons = nullptr;
   drag_state_t drag;
+  // Hit-test index over the focused workspace's slots, rebuilt on the first lookup
+  // after slots moved, were added or removed, or the focus changed
+  layout::rect_grid_t slot_grid; int slot_grid_ws = -1; bool slot_grid_dirty = true;
+  std::tuple<int, int, int, int, int> arranged_for{};  // output size, workspaces, spacing, panel height
 
-  activities_view_t(wf::output_t *out) : output(out) { desktop_anim.set_duration(300); carousel_scroll.set_duration(300); }
+  activities_view_t(wf::output_t *out) : output(out), carousel_scroll(anims), desktop_anim(anims) { desktop_anim.set_duration(300); carousel_scroll.set_duration(300); }
   ~activities_view_t() { cleanup_all(); }
 
   void set_config(int cr, int sp, int ph, int ad) {
@@ -447,19 +973,27 @@ public:
 
   void toggle() { is_active ? deactivate() : activate(); }
 
-  std::vector<wayfire_toplevel_view> get_views_on_workspace(wf::point_t ws) {
+  // Index of the workspace whose area contains the view's center, -1 if off the grid
+  int ws_index_of_view(wayfire_toplevel_view tv, wf::point_t cur, wf::geometry_t og) const {
+    auto vg = tv->get_geometry();
+    int vws_x = cur.x + (int)std::floor((float)(vg.x + vg.width/2) / og.width);
+    int vws_y = cur.y + (int)std::floor((float)(vg.y + vg.height/2) / og.height);
+    if (vws_x < 0 || vws_x >= ws_cols || vws_y < 0 || vws_y >= ws_rows) return -1;
+    return ws_point_to_index({vws_x, vws_y});
+  }
+
+  // One pass over the workspace set's views, bucketed by workspace index
+  std::vector<std::vector<wayfire_toplevel_view>> bucket_views_by_workspace() {
     auto cur = output->wset()->get_current_workspace();
     auto og = output->get_layout_geometry();
-    std::vector<wayfire_toplevel_view> result;
+    std::vector<std::vector<wayfire_toplevel_view>> buckets(total_ws);
     for (auto &v : output->wset()->get_views(wf::WSET_MAPPED_ONLY)) {
       auto tv = wf::toplevel_cast(v);
       if (!tv || tv->get_output() != output || tv->minimized || !tv->is_mapped()) continue;
-      auto vg = tv->get_geometry();
-      int vws_x = cur.x + (int)std::floor((float)(vg.x + vg.width/2) / og.width);
-      int vws_y = cur.y + (int)std::floor((float)(vg.y + vg.height/2) / og.height);
-      if (vws_x == ws.x && vws_y == ws.y) result.push_back(tv);
+      int wi = ws_index_of_view(tv, cur, og);
+      if (wi >= 0) buckets[wi].push_back(tv);
     }
-    return result;
+    return buckets;
   }
 
   wf::point_t ws_index_to_point(int idx) const { return {idx % ws_cols, idx / ws_cols}; }
@@ -467,61 +1001,116 @@ public:
 
   void activate() {
     if (is_active) return;
-    is_active = is_animating = true; drag.reset();
-
-    auto wsize = output->wset()->get_workspace_grid_size();
-    ws_cols = wsize.width; ws_rows = wsize.height; total_ws = ws_cols * ws_rows;
-    cur_ws = output->wset()->get_current_workspace();
-    orig_ws = cur_ws;
-    focused_ws = ws_point_to_index(cur_ws);
-
-    ws_windows.clear(); ws_windows.resize(total_ws);
+    is_active = is_animating = true; exiting = false; drag.reset(); slot_grid_dirty = true;
+    read_workspace_grid();
     auto og = output->get_layout_geometry();
 
+    auto buckets = bucket_views_by_workspace();
     for (int i = 0; i < total_ws; i++) {
       auto wsp = ws_index_to_point(i);
       int ox = (wsp.x - cur_ws.x) * og.width, oy = (wsp.y - cur_ws.y) * og.height;
-      for (auto &tv : get_views_on_workspace(wsp)) {
-        window_slot_t s; s.view = tv;
+      ws_windows[i].slots.reserve(buckets[i].size());
+      for (auto &tv : buckets[i]) {
+        window_slot_t s(anims); s.view = tv;
         auto vg = tv->get_geometry();
         s.orig_geo = {vg.x - ox, vg.y - oy, vg.width, vg.height};
         if (s.orig_geo.width <= 0) s.orig_geo.width = 100;
         if (s.orig_geo.height <= 0) s.orig_geo.height = 100;
         s.app_id = tv->get_app_id(); s.app_name = window_slot_t::make_app_name(tv);
-        ws_windows[i].slots.push_back(s);
+        ws_windows[i].slots.push_back(std::move(s));
       }
     }
 
     arrange();
-    for (int i = 0; i < total_ws; i++) { attach_transformers_for_ws(i); load_icons_for_ws(i); }
+    for (auto &wd : ws_windows) for (auto &s : wd.slots) s.start_anim(true, anim_duration);
+    for (int i = 0; i < total_ws; i++) load_icons_for_ws(i);
 
     carousel_scroll.set_duration(anim_duration);
     carousel_scroll.warp(scroll_target_for(focused_ws));
+    update_attached_ws();
 
     desktop_anim.warp({0, 0, og.width, og.height});
     desktop_anim.animate_to(preview_geo);
   }
 
+  void read_workspace_grid() {
+    auto wsize = output->wset()->get_workspace_grid_size();
+    ws_cols = wsize.width; ws_rows = wsize.height; total_ws = ws_cols * ws_rows;
+    cur_ws = output->wset()->get_current_workspace();
+    orig_ws = cur_ws;
+    focused_ws = ws_point_to_index(cur_ws);
+
+    // Slot vectors keep their capacity across activations
+    for (auto &wd : ws_windows) { wd.slots.clear(); wd.transformers_attached = false; }
+    ws_windows.resize(total_ws);
+  }
+
+  // Pre-warm support: lays out previews and thumbnails (no windows) as activate() would
+  void prepare_geometry() {
+    if (is_active) return;
+    read_workspace_grid(); arrange();
+  }
+
+  // Capture scale the first overview frame asks for: the zoom target full size,
+  // everything else thumbnail-sized (ws_capture_tier while desktop_anim runs)
+  float entry_capture_tier(int ws_idx) const {
+    auto og = output->get_layout_geometry();
+    if (ws_idx == focused_ws || ws_geos.empty() || og.width <= 0) return 1.0f;
+    return std::min(1.0f, (float)ws_geos[0].width / og.width);
+  }
+
+  // Starts the async icon lookups for every window activate() would show
+  void warm_icons() {
+    if (!icons) return;
+    wf::gles::run_in_context([&] {
+      for (auto &v : output->wset()->get_views(wf::WSET_MAPPED_ONLY)) {
+        auto tv = wf::toplevel_cast(v);
+        if (!tv || tv->get_output() != output || tv->minimized) continue;
+        icons->get(tv->get_app_id(), window_slot_t::make_app_name(tv), icon_size, output->handle->scale);
+      }
+    });
+  }
+
   void load_icons_for_ws(int wi) {
     if (wi < 0 || wi >= (int)ws_windows.size()) return;
+    if (!icons) return;
     wf::gles::run_in_context([&] {
       for (auto &s : ws_windows[wi].slots)
-        if (!s.icon.load_for_app(s.app_id, icon_size)) s.icon.create_fallback(s.app_name, icon_size);
+        if (!s.icon) s.icon = icons->get(s.app_id, s.app_name, icon_size, output->handle->scale);
     });
   }
 
   void attach_transformers_for_ws(int wi) {
     if (wi < 0 || wi >= (int)ws_windows.size()) return;
     auto &wd = ws_windows[wi]; if (wd.transformers_attached) return;
-    for (auto &s : wd.slots) {
-      if (!s.view || !s.view->is_mapped()) continue;
-      s.transformer = std::make_shared<wf::scene::view_2d_transformer_t>(s.view);
-      s.view->get_transformed_node()->add_transformer(s.transformer, wf::TRANSFORMER_2D, TRANSFORMER_NAME);
-      s.start_anim(true, anim_duration);
-    }
+    for (auto &s : wd.slots) attach_transformer(s);
     wd.transformers_attached = true;
   }
 
+  // The slot's animation runs whether or not it is attached, so a late attach picks up mid-flight
+  void attach_transformer(window_slot_t &s) {
+    if (!s.view || !s.view->is_mapped() || s.transformer) return;
+    s.transformer = std::make_shared<wf::scene::view_2d_transformer_t>(s.view);
+    s.view->get_transformed_node()->add_transformer(s.transformer, wf::TRANSFORMER_2D, TRANSFORMER_NAME);
+    s.update_transformer();
+  }
+
+  // Workspaces get transformers once their large preview is on screen at the current or
+  // target scroll, and lose them again once it is more than DETACH_DISTANCE previews off
+  // screen at both, so a short scroll back does not attach and detach on every step.
+  // Both follow the carousel, not the focus, so a long scroll drops what it passed.
+  static constexpr int DETACH_DISTANCE = 2;
+
+  void update_attached_ws() {
+    float margin = DETACH_DISTANCE * (preview_geo.width + carousel_gap);
+    float cur = carousel_scroll.value(), tgt = carousel_scroll.target();
+    for (int i = 0; i < (int)ws_windows.size(); i++) {
+      if (large_ws_visible_at(i, cur) || large_ws_visible_at(i, tgt)) attach_transformers_for_ws(i);
+      else if (ws_windows[i].transformers_attached && !large_ws_visible_at(i, cur, margin) && !large_ws_visible_at(i, tgt, margin))
+        detach_transformers_for_ws(i);
+    }
+  }
+
   void detach_transformers_for_ws(int wi) {
     if (wi < 0 || wi >= (int)ws_windows.size()) return;
     auto &wd = ws_windows[wi];
@@ -533,7 +1122,7 @@ public:
   }
 
   void deactivate() {
-    if (!is_active) return; drag.reset(); is_animating = true;
+    if (!is_active) return; drag.reset(); is_animating = true; exiting = true;
     for (auto &wd : ws_windows) for (auto &s : wd.slots) s.start_anim(false, anim_duration);
     if (focused_ws != ws_point_to_index(orig_ws)) { pending_ws = focused_ws; switching_ws = true; }
     auto og = output->get_layout_geometry();
@@ -541,7 +1130,7 @@ public:
   }
 
   void deactivate_to_ws(int idx) {
-    if (!is_active) return; drag.reset();
+    if (!is_active) return; drag.reset(); exiting = true;
     pending_ws = idx; switching_ws = true;
     // Animate windows back to original positions
     for (auto &wd : ws_windows) for (auto &s : wd.slots) s.start_anim(false, anim_duration);
@@ -556,9 +1145,9 @@ public:
   }
 
   void cleanup_all() {
-    wf::gles::run_in_context_if_gles([&] { for (auto &wd : ws_windows) for (auto &s : wd.slots) s.icon.destroy(); });
     for (int i = 0; i < (int)ws_windows.size(); i++) detach_transformers_for_ws(i);
-    ws_windows.clear();
+    for (auto &wd : ws_windows) wd.slots.clear();
+    relayout_ws.clear();
   }
 
   void navigate_to(int ws_idx) {
@@ -576,16 +1165,18 @@ public:
   }
 
   void tick() {
-    desktop_anim.tick(); carousel_scroll.tick();
-    for (auto &wd : ws_windows) for (auto &s : wd.slots) { s.anim.tick(); s.update_transformer(); if (s.view && s.view->is_mapped()) s.view->damage(); }
+    if (anims.active() > 0) slot_grid_dirty = true;
+    anims.tick();
+    update_attached_ws();
+    // Only slots whose transform actually moved damage their view; the carousel scroll
+    // does not touch transformers at all
+    for (auto &wd : ws_windows) for (auto &s : wd.slots) s.update_transformer();
     check_done();
   }
 
   void check_done() {
     if (!is_animating) return;
-    bool any = desktop_anim.is_animating() || carousel_scroll.is_animating();
-    for (auto &wd : ws_windows) { for (auto &s : wd.slots) if (s.anim.is_animating()) { any = true; break; } if (any) break; }
-    if (any) return;
+    if (anims.active() > 0) return;
     is_animating = false;
     auto og = output->get_layout_geometry(); auto cur = desktop_anim.current();
     if (cur.width >= og.width - 10) {
@@ -594,21 +1185,15 @@ public:
     }
   }
 
-  static void gnome_grid(int n, float area_aspect, int &cols, int &rows) {
-    if (n <= 0) { cols = rows = 1; return; } if (n == 1) { cols = rows = 1; return; }
-    if (n == 2) { cols = 2; rows = 1; return; } if (n == 3) { cols = 3; rows = 1; return; }
-    float best_score = 1e9f; int best_c = 2, best_r = 1;
-    for (int c = 2; c <= std::min(n, 6); c++) {
-      int r = (n + c - 1) / c; float ga = (float)c / r;
-      float rd = std::abs(ga - area_aspect) / area_aspect;
-      float ep = (float)(c * r - n) / n * 0.5f; float sc = rd + ep;
-      if (sc < best_score) { best_score = sc; best_c = c; best_r = r; }
-    }
-    cols = best_c; rows = best_r;
-  }
-
   void arrange() {
     auto og = output->get_layout_geometry();
+    auto key = std::make_tuple(og.width, og.height, total_ws, spacing, panel_height);
+    if (key != arranged_for) { arranged_for = key; arrange_workspaces(og); }
+    for (int wi = 0; wi < total_ws; wi++) arrange_ws_windows(wi);
+  }
+
+  // Thumbnail strip and large preview geometry; only depend on arranged_for
+  void arrange_workspaces(wf::geometry_t og) {
 
     int th = og.height * 0.10;
     int tw = th * og.width / og.height;
@@ -634,64 +1219,69 @@ public:
     preview_geo = {mx, my, mw, mh};
 
     carousel_gap = spacing * 2;
-
-    for (int wi = 0; wi < total_ws; wi++) arrange_ws_windows(wi);
   }
 
+  // Window targets of workspace wi; recomputed only if its windows or the area changed
   void arrange_ws_windows(int wi) {
     if (wi < 0 || wi >= (int)ws_windows.size()) return;
-    auto &wd = ws_windows[wi]; if (wd.slots.empty()) return;
-    auto og = output->get_layout_geometry();
-    int n = (int)wd.slots.size(); int cols, rows;
-    gnome_grid(n, (float)preview_geo.width / preview_geo.height, cols, rows);
-
-    int inset_x = spacing, inset_y = spacing, inset_bot = spacing;
-    int waw = og.width - inset_x * 2, wah = og.height - inset_y - inset_bot, gap = spacing;
-    int cw = (waw - gap * (cols - 1)) / cols, ch = (wah - gap * (rows - 1)) / rows;
-    int gh = rows * ch + (rows - 1) * gap;
-    int gy = inset_y + (wah - gh) / 2;
-
-    for (int i = 0; i < n; i++) {
-      auto &s = wd.slots[i]; int row = i / cols;
-      int itr = (row == rows - 1) ? (n - row * cols) : cols;
-      int row_w = itr * cw + (itr - 1) * gap;
-      int row_x = (og.width - row_w) / 2;
-      int cir = i - row * cols;
-      int cx = row_x + cir * (cw + gap), cy = gy + row * (ch + gap);
-      double sc = std::min((double)cw / s.orig_geo.width, (double)ch / s.orig_geo.height) * 0.95;
-      int sw = (int)(s.orig_geo.width * sc), sh = (int)(s.orig_geo.height * sc);
-      s.target_geo = { cx + (cw - sw) / 2, cy + (ch - sh) / 2, sw, sh };
+    auto &wd = ws_windows[wi]; auto &slots = wd.slots; if (slots.empty()) return;
+    auto area = wf::dimensions(output->get_layout_geometry()); int n = slots.size();
+    bool hit = wd.layout_area == area && wd.layout_spacing == spacing && (int)wd.layout_orig.size() == n;
+    for (int i = 0; hit && i < n; i++) hit = slots[i].orig_geo == wd.layout_orig[i];
+    if (!hit) {
+      wd.layout_orig.resize(n); wd.layout_target.resize(n);
+      for (int i = 0; i < n; i++) wd.layout_orig[i] = slots[i].orig_geo;
+      layout::arrange_rows(n, area, spacing, [&] (int i) { return wd.layout_orig[i]; }, [&] (int i, wf::geometry_t g) { wd.layout_target[i] = g; });
+      wd.layout_area = area; wd.layout_spacing = spacing;
     }
+    for (int i = 0; i < n; i++) slots[i].target_geo = wd.layout_target[i];
   }
 
   // Get large preview render geo for workspace ws_idx
   // Returns in output-local screen coordinates (Y-down)
   // scroll_target_for() already centers the focused ws, so no extra offset needed
   wf::geometry_t get_large_ws_render_geo(int ws_idx) const {
-    float scroll = carousel_scroll.value();
-    float base_x = ws_idx * (preview_geo.width + carousel_gap);
-    float rx = base_x - scroll;
-    return {(int)rx, preview_geo.y, preview_geo.width, preview_geo.height};
+    return layout::carousel_geo(ws_idx, carousel_scroll.value(), preview_geo, carousel_gap);
+  }
+
+  // Whether the large preview of ws_idx intersects the output at the current scroll
+  bool is_large_ws_visible(int ws_idx) const { return large_ws_visible_at(ws_idx, carousel_scroll.value()); }
+
+  // margin widens the output on both sides
+  bool large_ws_visible_at(int ws_idx, float scroll, float margin = 0) const {
+    auto og = output->get_layout_geometry();
+    float rx = ws_idx * (preview_geo.width + carousel_gap) - scroll;
+    return rx + preview_geo.width > -margin && rx < og.width + margin;
+  }
+
+  // Whether ws_idx is drawn large this frame (zoom target or on-screen carousel slot).
+  // Every other workspace is only visible as a small thumbnail.
+  bool is_ws_drawn_large(int ws_idx) const {
+    if (desktop_anim.is_animating()) return ws_idx == get_animating_ws();
+    return is_large_ws_visible(ws_idx);
+  }
+
+  // Fraction of the output size a capture of ws_idx has to provide: full size for the
+  // zoom target, the preview size for on-screen carousel slots, thumbnail size otherwise
+  float ws_capture_tier(int ws_idx) const {
+    auto og = output->get_layout_geometry();
+    if (og.width <= 0 || preview_geo.width <= 0 || ws_geos.empty()) return 1.0f;
+    if (!is_ws_drawn_large(ws_idx)) return std::min(1.0f, (float)ws_geos[0].width / og.width);
+    if (desktop_anim.is_animating()) return 1.0f;
+    return std::min(1.0f, (float)preview_geo.width / og.width);
   }
 
   // Hit testing: screen-local point — NO Y-flip needed, coords match screen space
   int find_large_ws_at(wf::pointf_t screen_local) {
-    for (int i = 0; i < total_ws; i++) {
-      auto g = get_large_ws_render_geo(i);
-      if (screen_local.x >= g.x && screen_local.x < g.x + g.width &&
-          screen_local.y >= g.y && screen_local.y < g.y + g.height) return i;
-    }
-    return -1;
+    return layout::carousel_at(total_ws, screen_local, carousel_scroll.value(), preview_geo, carousel_gap);
   }
 
   int find_thumb_ws_at(wf::pointf_t global_p) {
     auto og = output->get_layout_geometry();
-    float lx = global_p.x - og.x, ly = og.height - (global_p.y - og.y);
-    for (size_t i = 0; i < ws_geos.size(); i++) {
-      auto &g = ws_geos[i];
-      if (lx >= g.x && lx < g.x + g.width && ly >= g.y && ly < g.y + g.height) return i;
-    }
-    return -1;
+    wf::pointf_t lp{global_p.x - og.x, og.height - (global_p.y - og.y)};
+    if (ws_geos.empty()) return -1;
+    int step = ws_geos.size() > 1 ? ws_geos[1].x - ws_geos[0].x : 0;
+    return layout::uniform_row_at((int)ws_geos.size(), lp, ws_geos[0], step);
   }
 
   // Map screen-local → workspace-local (same math as original screen_to_workspace)
@@ -710,11 +1300,11 @@ public:
     if (find_large_ws_at(screen_local) != focused_ws) return -1;
     auto wp = screen_to_ws_local(screen_local, focused_ws);
     auto &slots = ws_windows[focused_ws].slots;
-    for (int i = (int)slots.size() - 1; i >= 0; i--) {
-      auto g = slots[i].anim.current();
-      if (wp.x >= g.x && wp.x < g.x + g.width && wp.y >= g.y && wp.y < g.y + g.height) return i;
+    if (slot_grid_dirty || slot_grid_ws != focused_ws) {
+      slot_grid.build((int)slots.size(), [&] (int i) { return slots[i].anim.current(); });
+      slot_grid_ws = focused_ws; slot_grid_dirty = false;
     }
-    return -1;
+    return slot_grid.topmost_at(wp);
   }
 
   wayfire_toplevel_view find_view_at(wf::pointf_t screen_local) {
@@ -724,6 +1314,32 @@ public:
     return nullptr;
   }
 
+  // Screen-local rect of slot idx of the focused workspace, as find_slot_at sees it
+  wf::geometry_t slot_screen_rect(int idx) const {
+    auto og = output->get_layout_geometry(); auto dg = get_large_ws_render_geo(focused_ws);
+    auto g = ws_windows[focused_ws].slots[idx].anim.current();
+    float sx = (float)dg.width / og.width, sy = (float)dg.height / og.height;
+    return {(int)(dg.x + g.x * sx), (int)((float)og.height - dg.y - dg.height + g.y * sy), (int)(g.width * sx), (int)(g.height * sy)};
+  }
+
+  wf::pointf_t slot_screen_center(int idx) const {
+    auto r = slot_screen_rect(idx);
+    return {r.x + r.width / 2.0f, r.y + r.height / 2.0f};
+  }
+
+  // Output-layout area a hover change of v repaints: its window plus the app icon,
+  // which can hang over the edge of small windows. Empty if v has no focused slot.
+  wf::geometry_t hover_damage_rect(wayfire_view v) const {
+    if (!v || focused_ws < 0 || focused_ws >= (int)ws_windows.size()) return {0, 0, 0, 0};
+    auto &slots = ws_windows[focused_ws].slots;
+    for (int i = 0; i < (int)slots.size(); i++) {
+      if (slots[i].view != v) continue;
+      auto og = output->get_layout_geometry(); auto r = slot_screen_rect(i); int pad = icon_size / 2 + 4;
+      return {og.x + r.x - pad, og.y + r.y - pad, r.width + 2 * pad, r.height + 2 * pad};
+    }
+    return {0, 0, 0, 0};
+  }
+
   // Drag
   bool start_drag(wf::pointf_t sl) {
     if (drag.active) return false;
@@ -738,7 +1354,7 @@ public:
     drag.float_width = drag.initial_screen_geo.width; drag.float_height = drag.initial_screen_geo.height;
     drag.view_geo = s.view->get_geometry();
     drag.grab_offset_in_window = { sl.x - (float)drag.initial_screen_geo.x, sl.y - (float)drag.initial_screen_geo.y };
-    drag.needs_capture = true; drag.has_snapshot = false;
+    s.dragged = true; s.update_transformer();
     return true;
   }
 
@@ -756,16 +1372,11 @@ public:
     int at = -1;
     if (tw >= 0 && tw != focused_ws) at = tw; else if (tl >= 0) at = tl;
     if (at >= 0 && drag.view) {
-      auto moved_view = drag.view;
+      auto moved_view = drag.view; int from = drag.slot_index;
       move_view_to_workspace(moved_view, at);
-      // Remove from source workspace
-      if (drag.slot_index >= 0 && drag.slot_index < (int)ws_windows[focused_ws].slots.size()) {
-        auto &s = ws_windows[focused_ws].slots[drag.slot_index];
-        if (s.view && s.view->is_mapped() && s.transformer) { s.reset_transformer(); s.view->get_transformed_node()->rem_transformer(TRANSFORMER_NAME); }
-        wf::gles::run_in_context([&] { s.icon.destroy(); });
-        ws_windows[focused_ws].slots.erase(ws_windows[focused_ws].slots.begin() + drag.slot_index);
-      }
       drag.reset();
+      // Remove from source workspace
+      remove_slot(focused_ws, from);
       // Rearrange source workspace
       rearrange_focused_ws();
       // Add to destination workspace and rearrange it
@@ -774,7 +1385,7 @@ public:
     }
     if (drag.slot_index >= 0 && focused_ws >= 0 && focused_ws < (int)ws_windows.size() && drag.slot_index < (int)ws_windows[focused_ws].slots.size()) {
       auto &s = ws_windows[focused_ws].slots[drag.slot_index];
-      if (s.transformer) s.transformer->alpha = 0.88f;
+      s.dragged = false; s.update_transformer();
       s.anim.set_duration(anim_duration); s.anim.animate_to(s.target_geo); is_animating = true;
     }
     drag.reset(); return false;
@@ -784,7 +1395,7 @@ public:
     if (!drag.active) return;
     if (drag.slot_index >= 0 && focused_ws >= 0 && focused_ws < (int)ws_windows.size() && drag.slot_index < (int)ws_windows[focused_ws].slots.size()) {
       auto &s = ws_windows[focused_ws].slots[drag.slot_index];
-      if (s.transformer) s.transformer->alpha = 0.88f;
+      s.dragged = false; s.update_transformer();
       s.anim.set_duration(anim_duration); s.anim.animate_to(s.target_geo); is_animating = true;
     }
     drag.reset();
@@ -794,7 +1405,60 @@ public:
     if (!view || !view->is_mapped()) return;
     auto t = ws_index_to_point(wi); auto c = output->wset()->get_current_workspace();
     auto og = output->get_layout_geometry(); auto vg = view->get_geometry();
+    moving_view = true;
     view->move(vg.x + (t.x - c.x) * og.width, vg.y + (t.y - c.y) * og.height);
+    moving_view = false;
+  }
+
+  // Drops slot idx of workspace wi, keeping the drag and hover state consistent
+  void remove_slot(int wi, int idx) {
+    if (wi < 0 || wi >= (int)ws_windows.size() || idx < 0 || idx >= (int)ws_windows[wi].slots.size()) return;
+    auto &slots = ws_windows[wi].slots; auto &s = slots[idx];
+    if (s.view && s.transformer) { s.reset_transformer(); s.view->get_transformed_node()->rem_transformer(TRANSFORMER_NAME); }
+    if (s.view == hovered_view) hovered_view = nullptr;
+    if (drag.active && wi == focused_ws) {
+      if (drag.slot_index == idx) drag.reset(); else if (drag.slot_index > idx) drag.slot_index--;
+    }
+    slots.erase(slots.begin() + idx);
+    slot_grid_dirty = true;
+  }
+
+  bool find_slot_of(wayfire_view v, int &wi, int &idx) const {
+    for (wi = 0; wi < (int)ws_windows.size(); wi++)
+      for (idx = 0; idx < (int)ws_windows[wi].slots.size(); idx++) if (ws_windows[wi].slots[idx].view == v) return true;
+    return false;
+  }
+
+  // ---- Live updates while the overview is open: only the affected workspace is re-laid out ----
+
+  void handle_view_mapped(wayfire_toplevel_view tv) {
+    if (!is_active || exiting || !tv || tv->get_output() != output || tv->minimized) return;
+    int wi, idx; if (find_slot_of(tv, wi, idx)) return;
+    int dest = ws_index_of_view(tv, cur_ws, output->get_layout_geometry());
+    if (dest >= 0) add_view_to_ws(tv, dest);
+  }
+
+  void handle_view_unmapped(wayfire_view v) {
+    if (!is_active) return;
+    int wi, idx; if (!find_slot_of(v, wi, idx)) return;
+    remove_slot(wi, idx);
+    if (!exiting) rearrange_ws(wi);
+  }
+
+  void handle_view_geometry_changed(wayfire_toplevel_view tv) {
+    if (!is_active || exiting || moving_view || !tv || !tv->is_mapped()) return;
+    int wi, idx; if (!find_slot_of(tv, wi, idx)) return;
+    if (drag.active && drag.view == tv) return;
+    int dest = ws_index_of_view(tv, cur_ws, output->get_layout_geometry());
+    if (dest != wi) {
+      remove_slot(wi, idx); rearrange_ws(wi);
+      if (dest >= 0) add_view_to_ws(tv, dest);
+      return;
+    }
+    auto og = output->get_layout_geometry(); auto wsp = ws_index_to_point(wi); auto vg = tv->get_geometry();
+    auto &s = ws_windows[wi].slots[idx];
+    s.orig_geo = {vg.x - (wsp.x - cur_ws.x) * og.width, vg.y - (wsp.y - cur_ws.y) * og.height, std::max(vg.width, 1), std::max(vg.height, 1)};
+    rearrange_ws(wi);
   }
 
   void rearrange_focused_ws() {
@@ -804,11 +1468,22 @@ public:
     is_animating = true;
   }
 
+  // Live updates animate one workspace's slots on their own, without is_animating,
+  // so only that workspace is repainted meanwhile (see relayout_ws)
   void rearrange_ws(int wi) {
     if (wi < 0 || wi >= (int)ws_windows.size()) return;
     arrange_ws_windows(wi);
     for (auto &s : ws_windows[wi].slots) { s.anim.set_duration(anim_duration); s.anim.animate_to(s.target_geo); }
-    is_animating = true;
+    if (std::find(relayout_ws.begin(), relayout_ws.end(), wi) == relayout_ws.end()) relayout_ws.push_back(wi);
+  }
+
+  // Forgets the workspaces whose relayout has settled
+  void prune_relayout() {
+    relayout_ws.erase(std::remove_if(relayout_ws.begin(), relayout_ws.end(), [&] (int wi) {
+      if (wi < 0 || wi >= (int)ws_windows.size()) return true;
+      for (auto &s : ws_windows[wi].slots) if (s.anim.is_animating()) return false;
+      return true;
+    }), relayout_ws.end());
   }
 
   void add_view_to_ws(wayfire_toplevel_view view, int dest_ws) {
@@ -820,7 +1495,7 @@ public:
     int oy = (wsp.y - cur_ws.y) * og.height;
     auto vg = view->get_geometry();
 
-    window_slot_t s;
+    window_slot_t s(anims);
     s.view = view;
     s.orig_geo = {vg.x - ox, vg.y - oy, vg.width, vg.height};
     if (s.orig_geo.width <= 0) s.orig_geo.width = 100;
@@ -828,23 +1503,17 @@ public:
     s.app_id = view->get_app_id();
     s.app_name = window_slot_t::make_app_name(view);
 
-    ws_windows[dest_ws].slots.push_back(s);
+    ws_windows[dest_ws].slots.push_back(std::move(s));
     int idx = (int)ws_windows[dest_ws].slots.size() - 1;
 
-    // Attach transformer
-    auto &ns = ws_windows[dest_ws].slots[idx];
-    ns.transformer = std::make_shared<wf::scene::view_2d_transformer_t>(ns.view);
-    ns.view->get_transformed_node()->add_transformer(ns.transformer, wf::TRANSFORMER_2D, TRANSFORMER_NAME);
-
     // Initialize animation at orig_geo so rearrange can animate to target
+    auto &ns = ws_windows[dest_ws].slots[idx];
     ns.anim.set_duration(anim_duration);
-    ns.anim.warp(ns.orig_geo);
+    ns.anim.warp(ns.orig_geo); slot_grid_dirty = true;
+    if (ws_windows[dest_ws].transformers_attached) attach_transformer(ns);
 
     // Load icon
-    wf::gles::run_in_context([&] {
-      if (!ns.icon.load_for_app(ns.app_id, icon_size))
-        ns.icon.create_fallback(ns.app_name, icon_size);
-    });
+    if (icons) wf::gles::run_in_context([&] { ns.icon = icons->get(ns.app_id, ns.app_name, icon_size, output->handle->scale); });
 
     // Rearrange destination workspace and animate all slots to new positions
     rearrange_ws(dest_ws);
@@ -887,68 +1556,439 @@ public:
 };
 
 // ============================================================================
-// GL Render Helpers (unchanged from original)
+// GL Render Helpers
 // ============================================================================
 
+// Optional per-quad decoration evaluated in the same fragment as the quad itself:
+// a plate of `border` px around the box (drawn behind it, like the old border rects)
+// and a drop shadow of the box offset by shadow_offset. Colors are straight alpha.
+struct quad_style_t {
+  float radius = 0;
+  float border = 0; glm::vec4 border_color{0, 0, 0, 0};
+  glm::vec2 shadow_offset{0, 0}; float shadow_softness = 1; float shadow_alpha = 0;
+};
+
+// Collects textured/solid/rounded quads for one frame into a persistent VBO and draws
+// them with one glDrawArrays per run of quads sharing a texture. Every quad carries its
+// tint, size, corner radius, border and shadow as vertex attributes, so nothing but the
+// bound texture changes between quads. Solid quads sample a 1x1 white texture.
+// GLES2 has no instancing, hence the per-instance data is replicated per vertex. It
+// also only guarantees 8 vertex attributes, so size, radius and border share one.
+class quad_batch_t {
+  struct vertex_t { float x, y, u, v, lx, ly, w, h, radius, border, r, g, b, a, br, bg, bb, ba, sx, sy, ss, sa; };
+  struct draw_t { GLuint tex; int first, count; };
+  OpenGL::program_t prog, surface_prog;
+  GLuint vbo = 0, white_tex = 0; size_t vbo_capacity = 0;
+  std::vector<vertex_t> verts; std::vector<draw_t> draws;
+  glm::mat4 ortho{1.0f};
+  const wf::render_target_t *target = nullptr; std::vector<wlr_box> clip;
+
+  // Runs draw once per damaged box with the scissor set to it
+  template<class F> void for_each_clip(F draw) {
+    for (auto &b : clip) { wf::gles::render_target_logic_scissor(*target, b); draw(); }
+    glDisable(GL_SCISSOR_TEST);
+  }
+
+  // uv is (u0, v0, u1, v1) for the top-left and bottom-right corners of box. The quad
+  // is grown by the decoration's extent, with uv and local coordinates extrapolated.
+  void push(GLuint tex, wf::geometry_t box, glm::vec4 uv, glm::vec4 c, const quad_style_t &st) {
+    float w = box.width, h = box.height;
+    if (w <= 0 || h <= 0) return;
+    float m = st.border + 1;
+    if (st.shadow_alpha > 0) m = std::max(m, std::max(std::abs(st.shadow_offset.x), std::abs(st.shadow_offset.y)) + st.shadow_softness + 1);
+    float x0 = box.x - m, y0 = box.y - m, x1 = box.x + w + m, y1 = box.y + h + m;
+    float du = (uv.z - uv.x) * m / w, dv = (uv.w - uv.y) * m / h;
+    float u0 = uv.x - du, v0 = uv.y - dv, u1 = uv.z + du, v1 = uv.w + dv;
+    float hx = w / 2 + m, hy = h / 2 + m;
+    auto bc = st.border_color; float sa = st.shadow_alpha;
+    auto vtx = [&](float x, float y, float u, float v, float lx, float ly) {
+      return vertex_t{x, y, u, v, lx, ly, w, h, st.radius, st.border, c.x, c.y, c.z, c.w,
+                      bc.x * bc.w, bc.y * bc.w, bc.z * bc.w, bc.w, st.shadow_offset.x, st.shadow_offset.y, st.shadow_softness, sa};
+    };
+    vertex_t q[4] = {vtx(x0, y0, u0, v0, -hx, -hy), vtx(x1, y0, u1, v0, hx, -hy), vtx(x1, y1, u1, v1, hx, hy), vtx(x0, y1, u0, v1, -hx, hy)};
+    for (int i : {0, 1, 2, 0, 2, 3}) verts.push_back(q[i]);
+    if (!draws.empty() && draws.back().tex == tex) draws.back().count += 6;
+    else draws.push_back({tex, (int)verts.size() - 6, 6});
+  }
+
+public:
+  void load() {
+    // box is (width, height, corner radius, border)
+    const char *vs = "#version 100\nattribute vec2 position; attribute vec2 uv; attribute vec2 local; attribute vec4 box; attribute vec4 color;\n"
+      "attribute vec4 border_color; attribute vec4 shadow;\n"
+      "varying vec2 vuv; varying vec2 vlocal; varying vec4 vbox; varying vec4 vcolor; varying vec4 vborder_color; varying vec4 vshadow;\n"
+      "uniform mat4 matrix;\n"
+      "void main() { gl_Position = matrix * vec4(position, 0.0, 1.0); vuv = uv; vlocal = local; vbox = box; vcolor = color;\n"
+      "  vborder_color = border_color; vshadow = shadow; }\n";
+    // Rounded-box signed distance, local coordinates centred on the box; no branches,
+    // the body, border plate and shadow coverage are all clamped distances.
+    const char *fs = "#version 100\n#ifdef GL_FRAGMENT_PRECISION_HIGH\nprecision highp float;\n#else\nprecision mediump float;\n#endif\n"
+      "varying vec2 vuv; varying vec2 vlocal; varying vec4 vbox; varying vec4 vcolor; varying vec4 vborder_color; varying vec4 vshadow;\n"
+      "uniform sampler2D smp;\n"
+      "float sd_box(vec2 p, vec2 b, float r) { vec2 q = abs(p) - b + r; return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r; }\n"
+      "void main() {\n"
+      "  vec2 hs = vbox.xy * 0.5; float r = min(vbox.z, min(hs.x, hs.y)); float border = vbox.w;\n"
+      "  float body = clamp(0.5 - sd_box(vlocal, hs, r), 0.0, 1.0);\n"
+      "  vec4 c = texture2D(smp, vuv) * vcolor * body;\n"
+      "  float plate = clamp(0.5 - sd_box(vlocal, hs + border, r + border), 0.0, 1.0);\n"
+      "  float sh = vshadow.w * clamp(0.5 - sd_box(vlocal - vshadow.xy, hs, r) / vshadow.z, 0.0, 1.0);\n"
+      "  vec4 under = vborder_color * plate; under += vec4(0.0, 0.0, 0.0, sh) * (1.0 - under.a);\n"
+      "  gl_FragColor = c + under * (1.0 - c.a);\n"
+      "}\n";
+    prog.compile(vs, fs);
+    // Client buffers come as RGBA, RGBX or external images; Wayfire fills in the sampler
+    const char *svs = "#version 100\nattribute vec2 position; attribute vec2 uv; attribute vec2 local; varying vec2 vuv; varying vec2 vlocal; uniform mat4 matrix;\n"
+      "void main() { gl_Position = matrix * vec4(position, 0.0, 1.0); vuv = uv; vlocal = local; }\n";
+    const char *sfs = "#version 100\n@builtin_ext@\nprecision mediump float;\n@builtin@\n"
+      "varying vec2 vuv; varying vec2 vlocal; uniform vec2 size; uniform float radius; uniform float alpha;\n"
+      "float sd_box(vec2 p, vec2 b, float r) { vec2 q = abs(p) - b + r; return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r; }\n"
+      "void main() { vec2 hs = size * 0.5; float body = clamp(0.5 - sd_box(vlocal, hs, min(radius, min(hs.x, hs.y))), 0.0, 1.0);\n"
+      "  gl_FragColor = get_pixel(vuv) * alpha * body; }\n";
+    surface_prog.compile(svs, sfs);
+    glGenBuffers(1, &vbo);
+    uint32_t white = 0xffffffff;
+    glGenTextures(1, &white_tex);
+    glBindTexture(GL_TEXTURE_2D, white_tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &white);
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+  void free() {
+    prog.free_resources(); surface_prog.free_resources();
+    if (vbo) { glDeleteBuffers(1, &vbo); vbo = 0; vbo_capacity = 0; }
+    if (white_tex) { glDeleteTextures(1, &white_tex); white_tex = 0; }
+  }
+
+  // Starts a frame in the output's layout coordinates (same projection as before).
+  // Everything drawn until the next begin() only touches the damaged part of t.
+  void begin(wf::geometry_t og, const wf::render_target_t &t, const wf::region_t &damage) {
+    ortho = glm::ortho<float>(og.x, og.x + og.width, og.y + og.height, og.y, -1, 1);
+    verts.clear(); draws.clear();
+    target = &t; clip.clear();
+    for (auto &b : damage) clip.push_back(wlr_box_from_pixman_box(b));
+  }
+  void clear(glm::vec4 c) {
+    glClearColor(c.x, c.y, c.z, c.w);
+    for_each_clip([] { glClear(GL_COLOR_BUFFER_BIT); });
+  }
+  void add_tex(GLuint tex, wf::geometry_t box, float alpha, bool flip_y, float radius = 0) {
+    quad_style_t st; st.radius = radius;
+    add_tex_region(tex, {0, 0, 1, 1}, box, alpha, flip_y, st);
+  }
+  void add_tex(GLuint tex, wf::geometry_t box, float alpha, bool flip_y, const quad_style_t &st) {
+    add_tex_region(tex, {0, 0, 1, 1}, box, alpha, flip_y, st);
+  }
+  // Draws the (u0, v0, u1, v1) sub-rectangle of tex, e.g. an atlas cell
+  void add_tex_region(GLuint tex, glm::vec4 uv, wf::geometry_t box, float alpha, bool flip_y, const quad_style_t &st = {}) {
+    if (flip_y) std::swap(uv.y, uv.w);
+    push(tex, box, uv, {alpha, alpha, alpha, alpha}, st);
+  }
+  // Whole tex multiplied by a premultiplied color
+  void add_tex_tinted(GLuint tex, wf::geometry_t box, glm::vec4 c, bool flip_y) {
+    glm::vec4 uv{0, 0, 1, 1};
+    if (flip_y) std::swap(uv.y, uv.w);
+    push(tex, box, uv, c, {});
+  }
+  void add_rect(wf::geometry_t box, glm::vec4 color) {
+    push(white_tex, box, {0, 0, 1, 1}, {color.x * color.w, color.y * color.w, color.z * color.w, color.w}, {});
+  }
+  void add_rect(wf::geometry_t box, glm::vec4 color, const quad_style_t &st) {
+    push(white_tex, box, {0, 0, 1, 1}, {color.x * color.w, color.y * color.w, color.z * color.w, color.w}, st);
+  }
+  // Only the border plate and shadow of st around an empty box
+  void add_shadow(wf::geometry_t box, const quad_style_t &st) {
+    push(white_tex, box, {0, 0, 1, 1}, {0, 0, 0, 0}, st);
+  }
+
+  // Draws the uv sub-rectangle of a texture of any type (e.g. a client buffer) with
+  // rounded corners, right away and after everything queued so far
+  void draw_texture(const wf::gles_texture_t &tex, glm::vec4 uv, wf::geometry_t box, float alpha, bool flip_y, float radius) {
+    if (box.width <= 0 || box.height <= 0) return;
+    flush();
+    if (flip_y) std::swap(uv.y, uv.w);
+    float x0 = box.x, y0 = box.y, x1 = box.x + box.width, y1 = box.y + box.height;
+    float hx = box.width / 2.0f, hy = box.height / 2.0f;
+    GLfloat pos[] = {x0, y0, x1, y0, x1, y1, x0, y1};
+    GLfloat uvs[] = {uv.x, uv.y, uv.z, uv.y, uv.z, uv.w, uv.x, uv.w};
+    GLfloat loc[] = {-hx, -hy, hx, -hy, hx, hy, -hx, hy};
+    surface_prog.use(tex.type); surface_prog.set_active_texture(tex);
+    surface_prog.uniformMatrix4f("matrix", ortho); surface_prog.uniform2f("size", box.width, box.height);
+    surface_prog.uniform1f("radius", radius); surface_prog.uniform1f("alpha", alpha);
+    surface_prog.attrib_pointer("position", 2, 0, pos); surface_prog.attrib_pointer("uv", 2, 0, uvs);
+    surface_prog.attrib_pointer("local", 2, 0, loc);
+    glEnable(GL_BLEND); glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    for_each_clip([] { glDrawArrays(GL_TRIANGLE_FAN, 0, 4); });
+    glDisable(GL_BLEND); glBindTexture(tex.target, 0); surface_prog.deactivate();
+  }
+
+  // Draws everything added since begin(); call inside a GLES subpass
+  void flush() {
+    if (draws.empty()) return;
+    size_t bytes = verts.size() * sizeof(vertex_t);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (bytes > vbo_capacity) { vbo_capacity = bytes * 2; glBufferData(GL_ARRAY_BUFFER, vbo_capacity, nullptr, GL_STREAM_DRAW); }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, verts.data());
+    prog.use(wf::TEXTURE_TYPE_RGBA); prog.uniformMatrix4f("matrix", ortho); prog.uniform1i("smp", 0);
+    auto at = [](size_t off) { return (const void*)off; };
+    int st = sizeof(vertex_t);
+    prog.attrib_pointer("position", 2, st, at(offsetof(vertex_t, x))); prog.attrib_pointer("uv", 2, st, at(offsetof(vertex_t, u)));
+    prog.attrib_pointer("local", 2, st, at(offsetof(vertex_t, lx))); prog.attrib_pointer("box", 4, st, at(offsetof(vertex_t, w)));
+    prog.attrib_pointer("color", 4, st, at(offsetof(vertex_t, r))); prog.attrib_pointer("border_color", 4, st, at(offsetof(vertex_t, br)));
+    prog.attrib_pointer("shadow", 4, st, at(offsetof(vertex_t, sx)));
+    glActiveTexture(GL_TEXTURE0);
+    glEnable(GL_BLEND); glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    for_each_clip([&] { for (auto &d : draws) { glBindTexture(GL_TEXTURE_2D, d.tex); glDrawArrays(GL_TRIANGLES, d.first, d.count); } });
+    glDisable(GL_BLEND); glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0); prog.deactivate();
+    verts.clear(); draws.clear();
+  }
+};
+
 struct gl_programs_t {
-  OpenGL::program_t tex, rounded, col; bool loaded = false;
+  OpenGL::program_t tex; quad_batch_t quads; bool loaded = false;
   void load() {
     if (loaded) return; loaded = true;
     const char *tv = "#version 100\nattribute vec2 position; attribute vec2 uv; varying vec2 vuv; uniform mat4 matrix;\nvoid main() { gl_Position = matrix * vec4(position, 0.0, 1.0); vuv = uv; }\n";
     const char *tf = "#version 100\nprecision mediump float; varying vec2 vuv; uniform sampler2D smp; uniform float alpha;\nvoid main() { vec4 c = texture2D(smp, vuv); gl_FragColor = vec4(c.rgb * alpha, c.a * alpha); }\n";
     tex.compile(tv, tf);
-    const char *rv = "#version 100\nprecision mediump float; attribute vec2 position; attribute vec2 uv; varying vec2 vuv; varying vec2 fc; uniform mat4 matrix; uniform vec2 size;\nvoid main() { gl_Position = matrix * vec4(position, 0.0, 1.0); vuv = uv; fc = uv * size; }\n";
-    const char *rf = "#version 100\nprecision mediump float; varying vec2 vuv; varying vec2 fc; uniform sampler2D smp; uniform float alpha; uniform float radius; uniform vec2 size;\nvoid main() { vec4 c = texture2D(smp, vuv); vec2 cd; if (fc.x < radius && fc.y < radius) cd = fc - vec2(radius); else if (fc.x > size.x - radius && fc.y < radius) cd = fc - vec2(size.x - radius, radius); else if (fc.x < radius && fc.y > size.y - radius) cd = fc - vec2(radius, size.y - radius); else if (fc.x > size.x - radius && fc.y > size.y - radius) cd = fc - vec2(size.x - radius, size.y - radius); else { gl_FragColor = vec4(c.rgb * alpha, c.a * alpha); return; } float d = length(cd); float aa = smoothstep(radius, radius - 1.5, d); gl_FragColor = vec4(c.rgb * alpha * aa, c.a * alpha * aa); }\n";
-    rounded.compile(rv, rf);
-    const char *cv = "#version 100\nattribute vec2 position; uniform mat4 matrix;\nvoid main() { gl_Position = matrix * vec4(position, 0.0, 1.0); }\n";
-    const char *cf = "#version 100\nprecision mediump float; uniform vec4 color;\nvoid main() { gl_FragColor = color; }\n";
-    col.compile(cv, cf);
-  }
-  void free() { tex.free_resources(); rounded.free_resources(); col.free_resources(); }
+    quads.load();
+  }
+  void free() { tex.free_resources(); quads.free(); }
 };
 
-inline void render_tex(OpenGL::program_t &prog, wf::output_t *out, GLuint tex, wf::geometry_t box, float alpha, bool flip_y) {
-  auto og = out->get_layout_geometry();
-  glm::mat4 ortho = glm::ortho<float>(og.x, og.x + og.width, og.y + og.height, og.y, -1, 1);
-  float v0 = flip_y ? 1.0f : 0.0f, v1 = flip_y ? 0.0f : 1.0f;
-  GLfloat verts[] = {(float)box.x, (float)box.y, (float)(box.x+box.width), (float)box.y, (float)(box.x+box.width), (float)(box.y+box.height), (float)box.x, (float)(box.y+box.height)};
-  GLfloat uvs[] = {0, v0, 1, v0, 1, v1, 0, v1};
-  prog.use(wf::TEXTURE_TYPE_RGBA); prog.uniformMatrix4f("matrix", ortho);
-  prog.uniform1i("smp", 0); prog.uniform1f("alpha", alpha);
-  glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, tex);
-  prog.attrib_pointer("position", 2, 0, verts); prog.attrib_pointer("uv", 2, 0, uvs);
-  glEnable(GL_BLEND); glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-  glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-  glDisable(GL_BLEND); glBindTexture(GL_TEXTURE_2D, 0); prog.deactivate();
-}
+// GPU state shared by every output: shaders and the quad VBO, the icon atlas and the
+// wallpaper. Owned by the plugin, so hotplugging an output compiles and uploads nothing.
+class gpu_resources_t {
+  std::weak_ptr<gl_programs_t> programs_;
 
-inline void render_rounded(OpenGL::program_t &prog, wf::output_t *out, GLuint tex, wf::geometry_t box, float alpha, float radius, bool flip_y) {
-  auto og = out->get_layout_geometry();
-  glm::mat4 ortho = glm::ortho<float>(og.x, og.x + og.width, og.y + og.height, og.y, -1, 1);
-  float v0 = flip_y ? 1.0f : 0.0f, v1 = flip_y ? 0.0f : 1.0f;
-  GLfloat verts[] = {(float)box.x, (float)box.y, (float)(box.x+box.width), (float)box.y, (float)(box.x+box.width), (float)(box.y+box.height), (float)box.x, (float)(box.y+box.height)};
-  GLfloat uvs[] = {0, v0, 1, v0, 1, v1, 0, v1};
-  prog.use(wf::TEXTURE_TYPE_RGBA); prog.uniformMatrix4f("matrix", ortho);
-  prog.uniform1i("smp", 0); prog.uniform1f("alpha", alpha);
-  prog.uniform1f("radius", radius); prog.uniform2f("size", box.width, box.height);
-  glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, tex);
+public:
+  icon_cache_t icons;
+  wallpaper_loader_t wallpaper;
+
+  // Compiled on first use and freed in the GL context once the last user lets go
+  std::shared_ptr<gl_programs_t> programs() {
+    if (auto p = programs_.lock()) return p;
+    std::shared_ptr<gl_programs_t> p(new gl_programs_t, [] (gl_programs_t *g) {
+      wf::gles::run_in_context_if_gles([&] { g->free(); }); delete g;
+    });
+    wf::gles::run_in_context([&] { p->load(); });
+    programs_ = p; return p;
+  }
+};
+
+// Draws the whole of src into the whole of dst. With linear filtering and a 2x reduction
+// each output pixel averages a 2x2 box, i.e. one level of a mip chain.
+inline void downsample_into(OpenGL::program_t &prog, GLuint src, wf::auxilliary_buffer_t &dst) {
+  auto sz = dst.get_size();
+  wf::gles::bind_render_buffer(dst.get_renderbuffer());
+  glViewport(0, 0, sz.width, sz.height);
+  GLfloat verts[] = {-1, -1, 1, -1, 1, 1, -1, 1};
+  GLfloat uvs[] = {0, 0, 1, 0, 1, 1, 0, 1};
+  prog.use(wf::TEXTURE_TYPE_RGBA); prog.uniformMatrix4f("matrix", glm::mat4(1.0f));
+  prog.uniform1i("smp", 0); prog.uniform1f("alpha", 1.0f);
+  glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, src);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   prog.attrib_pointer("position", 2, 0, verts); prog.attrib_pointer("uv", 2, 0, uvs);
-  glEnable(GL_BLEND); glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-  glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-  glDisable(GL_BLEND); glBindTexture(GL_TEXTURE_2D, 0); prog.deactivate();
+  glDisable(GL_BLEND); glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+  glBindTexture(GL_TEXTURE_2D, 0); prog.deactivate();
 }
 
-inline void render_rect(OpenGL::program_t &prog, wf::output_t *out, wf::geometry_t box, glm::vec4 color) {
-  auto og = out->get_layout_geometry();
-  glm::mat4 ortho = glm::ortho<float>(og.x, og.x + og.width, og.y + og.height, og.y, -1, 1);
-  GLfloat verts[] = {(float)box.x, (float)box.y, (float)(box.x+box.width), (float)box.y, (float)(box.x+box.width), (float)(box.y+box.height), (float)box.x, (float)(box.y+box.height)};
-  prog.use(wf::TEXTURE_TYPE_RGBA); prog.uniformMatrix4f("matrix", ortho);
-  prog.uniform4f("color", color); prog.attrib_pointer("position", 2, 0, verts);
-  glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-  glDisable(GL_BLEND); prog.deactivate();
+// ============================================================================
+// Frame Profiler — per-phase CPU time and GPU timer queries, debug only
+// ============================================================================
+
+enum profile_phase_t { PHASE_ACTIVATE, PHASE_TICK, PHASE_CAPTURE, PHASE_COMPOSITE, PHASE_COUNT };
+static const char *const PHASE_NAMES[PHASE_COUNT] = {"activate", "tick", "capture", "composite"};
+
+// p in [0, 1], nearest rank; 0 for no samples
+static float percentile_of(std::vector<float> v, float p) {
+  if (v.empty()) return 0;
+  auto k = v.begin() + std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5f));
+  std::nth_element(v.begin(), k, v.end());
+  return *k;
 }
 
+// Last N samples of one phase, in milliseconds
+struct rolling_samples_t {
+  static constexpr size_t N = 240;
+  std::vector<float> ring = std::vector<float>(N); size_t count = 0, head = 0;
+  void push(float ms) { ring[head] = ms; head = (head + 1) % N; count = std::min(count + 1, N); }
+  float percentile(float p) const { return percentile_of({ring.begin(), ring.begin() + count}, p); }
+};
+
+class frame_profiler_t {
+public:
+  bool enabled = false;
+  rolling_samples_t cpu[PHASE_COUNT], gpu[PHASE_COUNT];
+
+  // RAII CPU timer for one phase; a no-op while the profiler is off
+  struct scope_t {
+    frame_profiler_t *p; profile_phase_t ph; std::chrono::steady_clock::time_point t0;
+    scope_t(frame_profiler_t *pr, profile_phase_t phase) : p(pr && pr->enabled ? pr : nullptr), ph(phase) {
+      if (p) t0 = std::chrono::steady_clock::now();
+    }
+    scope_t(const scope_t&) = delete;
+    ~scope_t() { if (p) p->cpu[ph].push(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count()); }
+  };
+  scope_t scope(profile_phase_t ph) { return scope_t(this, ph); }
+
+  // GL context is current. Queries are read back a few frames later without stalling.
+  void begin_gpu(profile_phase_t ph) {
+    if (!enabled || !load_gpu()) return;
+    collect();
+    auto &q = queries[ph][next[ph]];
+    if (q.pending) return;  // ring full, drop this sample
+    if (!q.id) glGenQueriesEXT(1, &q.id);
+    glBeginQueryEXT(GL_TIME_ELAPSED_EXT, q.id); open = ph;
+  }
+  void end_gpu(profile_phase_t ph) {
+    if (open != ph) return;
+    glEndQueryEXT(GL_TIME_ELAPSED_EXT); open = PHASE_COUNT;
+    queries[ph][next[ph]].pending = true; next[ph] = (next[ph] + 1) % QUERY_DEPTH;
+  }
+
+  std::string summary() const {
+    std::string out; char buf[128];
+    for (int i = 0; i < PHASE_COUNT; i++) {
+      if (cpu[i].count == 0 && gpu[i].count == 0) continue;
+      snprintf(buf, sizeof(buf), "%-9s cpu %5.2f/%5.2f/%5.2f", PHASE_NAMES[i],
+               cpu[i].percentile(0.5f), cpu[i].percentile(0.95f), cpu[i].percentile(0.99f));
+      out += buf;
+      if (gpu[i].count) {
+        snprintf(buf, sizeof(buf), "  gpu %5.2f/%5.2f/%5.2f", gpu[i].percentile(0.5f), gpu[i].percentile(0.95f), gpu[i].percentile(0.99f));
+        out += buf;
+      }
+      out += "\n";
+    }
+    return out.empty() ? "no samples\n" : out;
+  }
+
+  // Redraws the HUD texture at most twice a second; GL context is current
+  GLuint hud_texture(int &w, int &h) {
+    if (hud_due()) { hud_updated = std::chrono::steady_clock::now(); draw_hud(); }
+    w = hud_w; h = hud_h; return hud_tex;
+  }
+  bool hud_due() const { return !hud_tex || std::chrono::steady_clock::now() - hud_updated > std::chrono::milliseconds(500); }
+  // Last HUD size; 0x0 until first drawn
+  wf::dimensions_t hud_size() const { return {hud_w, hud_h}; }
+
+  void free() {
+    for (auto &ph : queries) for (auto &q : ph) if (q.id) { glDeleteQueriesEXT(1, &q.id); q = {}; }
+    if (hud_tex) { glDeleteTextures(1, &hud_tex); hud_tex = 0; }
+  }
+
+private:
+  static constexpr int QUERY_DEPTH = 4;
+  struct query_t { GLuint id = 0; bool pending = false; };
+  query_t queries[PHASE_COUNT][QUERY_DEPTH];
+  int next[PHASE_COUNT] = {};
+  profile_phase_t open = PHASE_COUNT;
+  int gpu_state = 0;  // 0 unknown, 1 available, -1 missing
+  PFNGLGENQUERIESEXTPROC glGenQueriesEXT = nullptr;
+  PFNGLDELETEQUERIESEXTPROC glDeleteQueriesEXT = nullptr;
+  PFNGLBEGINQUERYEXTPROC glBeginQueryEXT = nullptr;
+  PFNGLENDQUERYEXTPROC glEndQueryEXT = nullptr;
+  PFNGLGETQUERYOBJECTUIVEXTPROC glGetQueryObjectuivEXT = nullptr;
+  PFNGLGETQUERYOBJECTUI64VEXTPROC glGetQueryObjectui64vEXT = nullptr;
+  GLuint hud_tex = 0; int hud_w = 0, hud_h = 0;
+  std::chrono::steady_clock::time_point hud_updated{};
+
+  bool load_gpu() {
+    if (gpu_state) return gpu_state > 0;
+    auto ext = (const char*)glGetString(GL_EXTENSIONS);
+    gpu_state = -1;
+    if (!ext || !strstr(ext, "GL_EXT_disjoint_timer_query")) { LOGI("overview: GL_EXT_disjoint_timer_query missing, CPU timings only"); return false; }
+    glGenQueriesEXT = (PFNGLGENQUERIESEXTPROC)eglGetProcAddress("glGenQueriesEXT");
+    glDeleteQueriesEXT = (PFNGLDELETEQUERIESEXTPROC)eglGetProcAddress("glDeleteQueriesEXT");
+    glBeginQueryEXT = (PFNGLBEGINQUERYEXTPROC)eglGetProcAddress("glBeginQueryEXT");
+    glEndQueryEXT = (PFNGLENDQUERYEXTPROC)eglGetProcAddress("glEndQueryEXT");
+    glGetQueryObjectuivEXT = (PFNGLGETQUERYOBJECTUIVEXTPROC)eglGetProcAddress("glGetQueryObjectuivEXT");
+    glGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC)eglGetProcAddress("glGetQueryObjectui64vEXT");
+    if (glGenQueriesEXT && glDeleteQueriesEXT && glBeginQueryEXT && glEndQueryEXT && glGetQueryObjectuivEXT && glGetQueryObjectui64vEXT)
+      gpu_state = 1;
+    return gpu_state > 0;
+  }
+
+  // Moves finished queries into the samples. A disjoint event (GPU clock change, reset)
+  // invalidates everything in flight.
+  void collect() {
+    GLint disjoint = 0; glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    for (int ph = 0; ph < PHASE_COUNT; ph++) for (auto &q : queries[ph]) {
+      if (!q.pending) continue;
+      GLuint avail = 0; glGetQueryObjectuivEXT(q.id, GL_QUERY_RESULT_AVAILABLE_EXT, &avail);
+      if (!avail) continue;
+      GLuint64 ns = 0; glGetQueryObjectui64vEXT(q.id, GL_QUERY_RESULT_EXT, &ns);
+      q.pending = false;
+      if (!disjoint) gpu[ph].push(ns / 1e6f);
+    }
+  }
+
+  void draw_hud() {
+    auto text = summary();
+    int lines = (int)std::count(text.begin(), text.end(), '\n');
+    hud_w = 520; hud_h = 12 + lines * 18;
+    auto surf = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, hud_w, hud_h);
+    auto cr = cairo_create(surf);
+    cairo_set_source_rgba(cr, 0, 0, 0, 0.7); cairo_paint(cr);
+    auto layout = pango_cairo_create_layout(cr);
+    auto fd = pango_font_description_from_string("Monospace 10");
+    pango_layout_set_font_description(layout, fd);
+    pango_layout_set_text(layout, text.c_str(), -1);
+    cairo_set_source_rgba(cr, 0.6, 1, 0.6, 1); cairo_move_to(cr, 8, 6); pango_cairo_show_layout(cr, layout);
+    pango_font_description_free(fd); g_object_unref(layout); cairo_destroy(cr);
+    cairo_surface_flush(surf);
+    if (!hud_tex) glGenTextures(1, &hud_tex);
+    glBindTexture(GL_TEXTURE_2D, hud_tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, hud_w, hud_h, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, cairo_image_surface_get_data(surf));
+    glBindTexture(GL_TEXTURE_2D, 0);
+    cairo_surface_destroy(surf);
+  }
+};
+
+// ============================================================================
+// Frame Governor — trades overview quality for frame rate on slow GPUs
+// ============================================================================
+
+// Judges back-to-back animation frames against the output's refresh interval. When
+// too many in a window run long it steps the quality level up (worse), after a few
+// clean windows back down. Level 0 is full quality; see overview_node_t::degrade.
+class frame_governor_t {
+  static constexpr int WINDOW = 60;        // frames per verdict
+  static constexpr int CLEAN_WINDOWS = 3;  // clean verdicts before stepping back up
+  std::chrono::steady_clock::time_point last{};
+  bool last_continuous = false;
+  int frames = 0, misses = 0, clean = 0;
+
+public:
+  bool enabled = true; int max_level = 3, miss_percent = 10;
+  int level = 0;
+
+  // Once per output frame. continuous says whether this frame was scheduled right
+  // after the previous one (an animation is running), i.e. whether the gap is
+  // meaningful. Returns whether the level changed.
+  bool frame(bool continuous, float period_ms) {
+    auto now = std::chrono::steady_clock::now();
+    float ms = std::chrono::duration<float, std::milli>(now - last).count();
+    bool judged = continuous && last_continuous;
+    last = now; last_continuous = continuous;
+    int old = level;
+    level = enabled ? std::min(level, max_level) : 0;
+    if (!enabled || !judged) return level != old;
+    frames++;
+    // A frame that missed vblank shows up as (at least) a doubled interval
+    if (ms > period_ms * 1.5f) misses++;
+    if (frames < WINDOW) return level != old;
+    if (misses * 100 > miss_percent * frames) { level = std::min(level + 1, max_level); clean = 0; }
+    else if (misses == 0 && ++clean >= CLEAN_WINDOWS) { level = std::max(level - 1, 0); clean = 0; }
+    frames = misses = 0;
+    return level != old;
+  }
+};
+
 // ============================================================================
 // Panel Render Node
 // ============================================================================
@@ -970,8 +2010,11 @@ public:
     }
     void render(const wf::scene::render_instruction_t &data) override {
       data.pass->custom_gles_subpass([&] {
-        if (self->panel && self->panel->tex_id)
-          render_tex(self->progs->tex, self->output, self->panel->tex_id, self->panel->get_render_geometry(), 1.0f, true);
+        if (!self->panel || !self->panel->tex_id) return;
+        auto &q = self->progs->quads;
+        q.begin(self->output->get_layout_geometry(), data.target, data.damage);
+        q.add_tex(self->panel->tex_id, self->panel->get_render_geometry(), 1.0f, true);
+        q.flush();
       });
     }
     void compute_visibility(wf::output_t*, wf::region_t&) override {}
@@ -994,98 +2037,290 @@ public:
 class overview_node_t : public wf::scene::node_t {
 public:
   wf::output_t *output; activities_view_t *activities; gl_programs_t *progs;
-  GLuint wallpaper_tex; top_panel_t *panel;
+  const std::shared_ptr<wallpaper_tex_t> *wallpaper; top_panel_t *panel; frame_profiler_t *profiler;
+  size_t capture_bytes = 0;  // workspace captures and their mips, for the benchmark report
+  // Composite windows straight from their buffers; the streams then only report damage
+  bool direct = false;
+  wf::geometry_t last_drag_box{0, 0, 0, 0}; int last_hover_ws = -1, last_hover_large_ws = -1;
 
   struct ws_capture_t {
     std::shared_ptr<wf::workspace_stream_node_t> stream;
     std::vector<wf::scene::render_instance_uptr> instances;
     wf::region_t damage; wf::auxilliary_buffer_t fb; wf::point_t ws;
+    std::chrono::steady_clock::time_point last_render{};
+    float scale = 0; wf::dimensions_t size{0, 0};  // fb was last rendered at, 0 before the first render
+    // Halvings of fb down to about thumbnail size; empty when fb already is thumbnail-sized
+    std::vector<wf::auxilliary_buffer_t> mips;
+    wf::auxilliary_buffer_t &thumb_fb() { return mips.empty() ? fb : mips.back(); }
   };
 
-  class render_instance_t : public wf::scene::render_instance_t {
-    std::shared_ptr<overview_node_t> self; wf::scene::damage_callback push_damage;
-  public:
-    std::vector<ws_capture_t> captures;
+  // Workspaces only visible as thumbnails refresh at most this often
+  static constexpr int THUMB_REFRESH_MS = 250;
+
+  // Frame governor level. 1: no icons during the zoom, no separate wallpaper overlay,
+  // and only the focused workspace refreshes live; 2: captures at 3/4 resolution and thumbnails refresh half as often;
+  // 3: captures at half resolution.
+  int degrade = 0;
+  float capture_scale() const { return degrade >= 3 ? 0.5f : degrade == 2 ? 0.75f : 1.0f; }
+  int thumb_refresh_ms() const { return degrade >= 2 ? THUMB_REFRESH_MS * 2 : THUMB_REFRESH_MS; }
+  bool refresh_throttled(int ws_idx) const {
+    return !activities->is_ws_drawn_large(ws_idx) || (degrade >= 1 && ws_idx != activities->focused_ws);
+  }
+
+  // Owned by the node rather than its render instance, so the streams and buffers
+  // survive the node leaving the scene between overview toggles. While hidden the
+  // streams keep collecting damage, and re-entering only re-renders what changed.
+  std::vector<ws_capture_t> captures;
+  wf::scene::damage_callback push_damage;  // of the live render instance, if any
+  const void *live_instance = nullptr;
+
+  // The streams' render instances are a snapshot of the scene like any other, so they
+  // are rebuilt whenever Wayfire would rebuild its own: for every new render instance
+  // of this node, and on child list or enabled changes, also while parked
+  bool instances_stale = true;
+  wf::signal::connection_t<wf::scene::root_node_update_signal> on_scene_update = [this](wf::scene::root_node_update_signal *ev) {
+    if (ev->flags & (wf::scene::update_flag::CHILDREN_LIST | wf::scene::update_flag::ENABLED)) instances_stale = true;
+  };
 
-    render_instance_t(overview_node_t *s, wf::scene::damage_callback pd) : push_damage(pd) {
-      self = std::dynamic_pointer_cast<overview_node_t>(s->shared_from_this());
-      auto wsize = s->output->wset()->get_workspace_grid_size();
+  // Builds the streams once, or again after the workspace grid changed, and their
+  // render instances whenever they went stale; both leave the captures fully damaged
+  void ensure_captures() {
+    auto wsize = output->wset()->get_workspace_grid_size();
+    if ((int)captures.size() != wsize.width * wsize.height) {
+      release_captures();
       for (int y = 0; y < wsize.height; y++) {
         for (int x = 0; x < wsize.width; x++) {
           ws_capture_t c; c.ws = {x, y};
-          c.stream = std::make_shared<wf::workspace_stream_node_t>(s->output, c.ws);
-          auto idx = captures.size();
-          c.stream->gen_render_instances(c.instances, [this, idx](const wf::region_t &d) {
-            if (idx < captures.size()) captures[idx].damage |= d;
-            push_damage(self->get_bounding_box());
-          }, s->output);
-          c.damage |= c.stream->get_bounding_box();
+          c.stream = std::make_shared<wf::workspace_stream_node_t>(output, c.ws);
           captures.push_back(std::move(c));
         }
       }
+      instances_stale = true;
     }
+    if (!instances_stale) return;
+    instances_stale = false;
+    wf::gles::run_in_context_if_gles([&] {
+      for (size_t idx = 0; idx < captures.size(); idx++) {
+        auto &c = captures[idx];
+        c.instances.clear();
+        c.stream->gen_render_instances(c.instances, [this, idx](const wf::region_t &d) {
+          if (idx >= captures.size()) return;
+          captures[idx].damage |= d;
+          if (!push_damage) return;
+          auto r = capture_damage_on_screen(idx, d);
+          // The drag thumbnail shows the view's own buffer in direct mode; repaint it on commits
+          if (direct && activities->drag.active) r |= last_drag_box;
+          push_damage(r);
+        }, output);
+        c.damage |= c.stream->get_bounding_box();
+      }
+    });
+  }
 
-    void capture_drag_snapshot(float scale) {
-      auto &drg = self->activities->drag;
-      if (!drg.needs_capture || drg.slot_index < 0) return;
-      int fws = self->activities->focused_ws;
-      if (fws < 0 || fws >= (int)self->activities->ws_windows.size()) return;
-      if (drg.slot_index >= (int)self->activities->ws_windows[fws].slots.size()) return;
-      auto &s = self->activities->ws_windows[fws].slots[drg.slot_index];
-      if (!s.view || !s.view->is_mapped() || !s.transformer) { drg.needs_capture = false; return; }
-      auto geo = drg.view_geo;
-      if (geo.width <= 0 || geo.height <= 0) { drg.needs_capture = false; return; }
-
-      drg.snapshot_fb.allocate({geo.width, geo.height}, scale);
-      float sa = s.transformer->alpha, ssx = s.transformer->scale_x, ssy = s.transformer->scale_y;
-      float stx = s.transformer->translation_x, sty = s.transformer->translation_y;
-      s.transformer->alpha = 1.0f; s.transformer->scale_x = s.transformer->scale_y = 1.0f;
-      s.transformer->translation_x = s.transformer->translation_y = 0;
-
-      std::vector<wf::scene::render_instance_uptr> vi;
-      s.view->get_transformed_node()->gen_render_instances(vi, [](const wf::region_t&){}, self->output);
-      wf::render_target_t st{drg.snapshot_fb}; st.geometry = geo; st.scale = scale;
-      wf::render_pass_params_t sp;
-      sp.instances = &vi; sp.damage = wf::region_t{geo};
-      sp.reference_output = self->output; sp.target = st;
-      sp.flags = wf::RPASS_CLEAR_BACKGROUND;
-      wf::render_pass_t::run(sp);
-
-      s.transformer->alpha = 0.001f; s.transformer->scale_x = ssx; s.transformer->scale_y = ssy;
-      s.transformer->translation_x = stx; s.transformer->translation_y = sty;
-      drg.needs_capture = false; drg.has_snapshot = true;
+  // Render coordinates are the output's layout coordinates flipped vertically
+  wf::geometry_t to_layout(wf::geometry_t r) const {
+    auto og = output->get_layout_geometry();
+    return {r.x, 2 * og.y + og.height - r.y - r.height, r.width, r.height};
+  }
+
+  // Where workspace ws_idx is drawn right now, in layout coordinates: its thumbnail
+  // and its large preview unless that is off-screen
+  std::vector<wf::geometry_t> ws_screen_boxes(int ws_idx) const {
+    std::vector<wf::geometry_t> boxes; auto og = output->get_layout_geometry();
+    auto &wsg = activities->ws_geos;
+    if (ws_idx >= 0 && ws_idx < (int)wsg.size()) boxes.push_back(to_layout({og.x + wsg[ws_idx].x, og.y + wsg[ws_idx].y, wsg[ws_idx].width, wsg[ws_idx].height}));
+    wf::geometry_t lg{0, 0, 0, 0};
+    if (activities->desktop_anim.is_animating()) { if (ws_idx == activities->get_animating_ws()) lg = activities->desktop_anim.current(); }
+    else if (activities->is_large_ws_visible(ws_idx)) lg = activities->get_large_ws_render_geo(ws_idx);
+    if (lg.width > 0 && lg.height > 0) boxes.push_back(to_layout({og.x + lg.x, og.y + lg.y, lg.width, lg.height}));
+    return boxes;
+  }
+
+  // Damage d of capture idx's stream, scaled onto every place its workspace is drawn,
+  // so one busy window repaints its own spots rather than the whole output
+  wf::region_t capture_damage_on_screen(size_t idx, const wf::region_t &d) const {
+    wf::region_t r; auto wb = captures[idx].stream->get_bounding_box();
+    if (wb.width <= 0 || wb.height <= 0) return r;
+    auto local = d & wb;
+    for (auto &l : ws_screen_boxes(activities->ws_point_to_index(captures[idx].ws))) {
+      float kx = (float)l.width / wb.width, ky = (float)l.height / wb.height;
+      wf::region_t part;
+      for (auto &b : local) {
+        // One pixel more on each side for the bilinear footprint
+        int x0 = l.x + (int)std::floor((b.x1 - wb.x) * kx) - 1, y0 = l.y + (int)std::floor((b.y1 - wb.y) * ky) - 1;
+        int x1 = l.x + (int)std::ceil((b.x2 - wb.x) * kx) + 1, y1 = l.y + (int)std::ceil((b.y2 - wb.y) * ky) + 1;
+        part |= wf::geometry_t{x0, y0, x1 - x0, y1 - y0};
+      }
+      r |= part & l;
+    }
+    return r;
+  }
+
+  // Floating drag thumbnail, render coordinates
+  wf::geometry_t drag_float_box() const {
+    auto &drg = activities->drag; auto og = output->get_layout_geometry();
+    float scx = drg.initial_screen_geo.x + drg.initial_screen_geo.width / 2.0f + drg.current_cursor.x - drg.grab_cursor.x;
+    float scy = drg.initial_screen_geo.y + drg.initial_screen_geo.height / 2.0f + drg.current_cursor.y - drg.grab_cursor.y;
+    int fw = drg.float_width, fh = drg.float_height;
+    return {og.x + (int)(scx - fw / 2.0f), og.y + (int)(og.height - scy - fh / 2.0f), fw, fh};
+  }
+
+  // What a drag frame repaints: the thumbnail's old and new spot with its shadow, and
+  // the workspaces whose drop highlight toggled. Empty if nothing moved.
+  wf::region_t drag_damage() {
+    auto &drg = activities->drag; wf::region_t r;
+    wf::geometry_t box{0, 0, 0, 0};
+    if (drg.active && drg.float_width > 0 && drg.float_height > 0) {
+      auto b = to_layout(drag_float_box()); int pad = 8;
+      box = {b.x - pad, b.y - pad, b.width + 2 * pad, b.height + 2 * pad};
+    }
+    if (box != last_drag_box) { r |= last_drag_box; r |= box; last_drag_box = box; }
+    int hw = drg.active ? drg.hover_ws : -1, hl = drg.active ? drg.hover_large_ws : -1;
+    for (int ws : {hw, hl, last_hover_ws, last_hover_large_ws}) {
+      if (ws < 0 || (hw == last_hover_ws && hl == last_hover_large_ws)) continue;
+      for (auto &b : ws_screen_boxes(ws)) r |= wf::geometry_t{b.x - 4, b.y - 4, b.width + 8, b.height + 8};
+    }
+    last_hover_ws = hw; last_hover_large_ws = hl;
+    return r;
+  }
+
+  void release_captures() {
+    wf::gles::run_in_context_if_gles([&] { captures.clear(); });
+    capture_bytes = 0;
+  }
+
+  // Rebuilds the 2x box-filtered chain from fb down to about thumbnail size, so the
+  // small thumbnails never minify a large capture by more than 2x and do not shimmer.
+  void update_thumb_mips(ws_capture_t &c, int thumb_px) {
+    std::vector<wf::dimensions_t> dims;
+    for (auto d = c.fb.get_size(); thumb_px > 0 && d.width / 2 >= thumb_px && d.height >= 2;) {
+      d = {d.width / 2, d.height / 2}; dims.push_back(d);
+    }
+    c.mips.resize(dims.size());
+    if (dims.empty()) return;
+    wf::gles::run_in_context([&] {
+      GLuint src = wf::gles_texture_t::from_aux(c.fb).tex_id;
+      for (size_t k = 0; k < dims.size(); k++) {
+        c.mips[k].allocate(dims[k]);
+        downsample_into(progs->tex, src, c.mips[k]);
+        src = wf::gles_texture_t::from_aux(c.mips[k]).tex_id;
+      }
+    });
+  }
+
+  // Whether c has to be re-rendered at scale cs: it was damaged, or its buffer is at
+  // another scale or size. Nothing is allocated here, so a throttled capture keeps its
+  // old buffer, contents intact, until its refresh slot comes up.
+  bool capture_needs_render(const ws_capture_t &c, float cs) const {
+    return !c.damage.empty() || c.scale != cs || c.size != wf::dimensions(c.stream->get_bounding_box());
+  }
+
+  void render_capture(ws_capture_t &c, float cs, int thumb_px) {
+    auto wb = c.stream->get_bounding_box();
+    if (c.fb.allocate(wf::dimensions(wb), cs) == wf::buffer_reallocation_result_t::REALLOCATED) c.damage |= wb;
+    c.scale = cs; c.size = wf::dimensions(wb);
+    wf::render_target_t t{c.fb}; t.geometry = wb; t.scale = cs;
+    wf::render_pass_params_t p;
+    p.instances = &c.instances; p.damage = c.damage;
+    p.reference_output = output; p.target = t;
+    p.flags = wf::RPASS_CLEAR_BACKGROUND | wf::RPASS_EMIT_SIGNALS;
+    wf::render_pass_t::run(p); c.damage.clear();
+    update_thumb_mips(c, thumb_px);
+  }
+
+  void update_capture_bytes() {
+    capture_bytes = 0;
+    for (auto &c : captures) {
+      auto d = c.fb.get_size(); capture_bytes += (size_t)d.width * d.height * 4;
+      for (auto &m : c.mips) { d = m.get_size(); capture_bytes += (size_t)d.width * d.height * 4; }
+    }
+  }
+
+  // Renders the next capture the first overview frame would need, at the scale that
+  // frame uses (see activities_view_t::entry_capture_tier). Returns false once all are ready.
+  bool prewarm_step() {
+    ensure_captures();
+    if (direct) return false;
+    float scale = output->handle->scale;
+    auto &wsg = activities->ws_geos;
+    int thumb_px = wsg.empty() ? 0 : (int)(wsg[0].width * scale);
+    bool rendered = false;
+    wf::gles::run_in_context([&] {
+      for (auto &c : captures) {
+        float cs = scale * capture_scale() * activities->entry_capture_tier(activities->ws_point_to_index(c.ws));
+        if (!capture_needs_render(c, cs)) continue;
+        render_capture(c, cs, thumb_px);
+        c.last_render = std::chrono::steady_clock::now(); rendered = true;
+        break;
+      }
+    });
+    update_capture_bytes();
+    return rendered;
+  }
+
+  class render_instance_t : public wf::scene::render_instance_t {
+    std::shared_ptr<overview_node_t> self; wf::scene::damage_callback push_damage;
+    wf::wl_timer<false> thumb_refresh_timer; wf::region_t deferred_damage;
+    std::vector<ws_capture_t> &captures;
+  public:
+    render_instance_t(overview_node_t *s, wf::scene::damage_callback pd) : push_damage(pd), captures(s->captures) {
+      self = std::dynamic_pointer_cast<overview_node_t>(s->shared_from_this());
+      self->instances_stale = true; self->ensure_captures();
+      self->push_damage = pd; self->live_instance = this;
+    }
+    ~render_instance_t() {
+      if (self->live_instance == this) { self->push_damage = nullptr; self->live_instance = nullptr; }
     }
 
     void schedule_instructions(std::vector<wf::scene::render_instruction_t> &instr,
                                const wf::render_target_t &target, wf::region_t &damage) override {
       auto bbox = self->get_bounding_box();
       float scale = self->output->handle->scale;
-      if (self->activities->drag.needs_capture) capture_drag_snapshot(scale);
-
-      bool force = self->activities->is_animating || self->activities->drag.active
-                   || self->activities->carousel_scroll.is_animating();
-      for (auto &c : captures) {
-        auto wb = c.stream->get_bounding_box();
-        c.fb.allocate(wf::dimensions(wb), scale);
-        wf::render_target_t t{c.fb}; t.geometry = wb; t.scale = scale;
-        wf::render_pass_params_t p;
-        p.instances = &c.instances; p.damage = force ? wf::region_t{wb} : c.damage;
-        p.reference_output = self->output; p.target = t;
-        p.flags = wf::RPASS_CLEAR_BACKGROUND | wf::RPASS_EMIT_SIGNALS;
-        wf::render_pass_t::run(p); c.damage.clear();
+      auto prof = self->profiler->scope(PHASE_CAPTURE);
+      wf::gles::run_in_context_if_gles([&] { self->profiler->begin_gpu(PHASE_CAPTURE); });
+
+      // Zoom, carousel scroll and drag only change how captures are composited,
+      // so a workspace is re-rendered only when its stream reported damage.
+      // Workspaces drawn large refresh every frame, thumbnail-only ones are throttled
+      // (and, under the governor, large but unfocused ones).
+      // Each capture is sized to its largest on-screen footprint (see ws_capture_tier);
+      // a throttled one also waits for its slot to change size.
+      self->ensure_captures();
+      auto now = std::chrono::steady_clock::now(); bool deferred = false;
+      auto &wsg = self->activities->ws_geos;
+      int thumb_px = wsg.empty() ? 0 : (int)(wsg[0].width * scale);
+      if (self->direct) for (auto &c : captures) c.damage.clear();
+      for (int i = 0; i < (int)captures.size() && !self->direct; i++) {
+        auto &c = captures[i];
+        float cs = scale * self->capture_scale() * self->activities->ws_capture_tier(i);
+        if (!self->capture_needs_render(c, cs)) continue;
+        if (self->refresh_throttled(i) && now - c.last_render < std::chrono::milliseconds(self->thumb_refresh_ms())) {
+          for (auto &b : self->ws_screen_boxes(i)) deferred_damage |= b;
+          deferred = true; continue;
+        }
+        c.last_render = now;
+        self->render_capture(c, cs, thumb_px);
       }
+      wf::gles::run_in_context_if_gles([&] { self->profiler->end_gpu(PHASE_CAPTURE); });
+      self->update_capture_bytes();
+      if (deferred && !thumb_refresh_timer.is_connected())
+        thumb_refresh_timer.set_timeout(self->thumb_refresh_ms(), [this]() { push_damage(deferred_damage); deferred_damage.clear(); });
       instr.push_back({.instance = this, .target = target, .damage = damage & bbox});
       damage ^= bbox;
     }
 
     void render(const wf::scene::render_instruction_t &data) override { self->do_render(data, captures); }
     void compute_visibility(wf::output_t *out, wf::region_t &) override {
+      self->ensure_captures();  // never walk instances of nodes the scene dropped
       for (auto &c : captures) for (auto &i : c.instances) { wf::region_t r = c.stream->get_bounding_box(); i->compute_visibility(out, r); }
     }
   };
 
-  overview_node_t(wf::output_t *out, activities_view_t *act, gl_programs_t *p, GLuint wp, top_panel_t *pnl)
-    : node_t(false), output(out), activities(act), progs(p), wallpaper_tex(wp), panel(pnl) {}
+  overview_node_t(wf::output_t *out, activities_view_t *act, gl_programs_t *p, const std::shared_ptr<wallpaper_tex_t> *wp,
+                  top_panel_t *pnl, frame_profiler_t *prof)
+    : node_t(false), output(out), activities(act), progs(p), wallpaper(wp), panel(pnl), profiler(prof) {
+    wf::get_core().scene()->connect(&on_scene_update);
+  }
 
   void gen_render_instances(std::vector<wf::scene::render_instance_uptr> &i, wf::scene::damage_callback pd, wf::output_t *on) override {
     if (on != output) return;
@@ -1093,41 +2328,147 @@ public:
   }
   wf::geometry_t get_bounding_box() override { return output->get_layout_geometry(); }
 
+  int panel_height() const { return panel ? panel->height : 0; }
+
+  // A view's current main-surface buffer and the uv of its window geometry vg within it,
+  // since xdg clients may draw shadows outside that. Server-side decorations are not
+  // part of the buffer, so box (render coordinates, covering vg) shrinks to the client area.
+  static wlr_texture *view_texture(wayfire_toplevel_view v, wf::geometry_t vg, wf::geometry_t &box, glm::vec4 &uv) {
+    auto *surf = v->get_wlr_surface();
+    auto *tex = surf ? wlr_surface_get_texture(surf) : nullptr;
+    if (!tex || surf->current.width <= 0 || surf->current.height <= 0 || vg.width <= 0 || vg.height <= 0) return nullptr;
+    wlr_box g = {0, 0, surf->current.width, surf->current.height};
+    auto *xdg = wlr_xdg_surface_try_from_wlr_surface(surf);
+    if (xdg && xdg->current.geometry.width > 0 && xdg->current.geometry.height > 0) g = xdg->current.geometry;
+    float sw = surf->current.width, sh = surf->current.height;
+    uv = {g.x / sw, g.y / sh, (g.x + g.width) / sw, (g.y + g.height) / sh};
+    auto m = v->toplevel()->current().margins;
+    if (m.left + m.right < vg.width && m.top + m.bottom < vg.height) {
+      // box is Y-flipped, its smaller y is the window's bottom edge
+      float kx = (float)box.width / vg.width, ky = (float)box.height / vg.height;
+      box = {box.x + (int)(m.left * kx), box.y + (int)(m.bottom * ky),
+             box.width - (int)((m.left + m.right) * kx), box.height - (int)((m.top + m.bottom) * ky)};
+    }
+    return tex;
+  }
+
+  // Workspace ws_idx's preview at box: its capture, or in direct mode the wallpaper with
+  // every window drawn from its own buffer at its animated slot geometry. Windows drawn
+  // that way get their frame callbacks here, as nothing else renders them meanwhile.
+  void add_ws_preview(quad_batch_t &q, std::vector<ws_capture_t> &caps, int ws_idx, wf::geometry_t box,
+                      float alpha, const quad_style_t &st, bool thumb) {
+    if (!direct) {
+      auto t = wf::gles_texture_t::from_aux(thumb ? caps[ws_idx].thumb_fb() : caps[ws_idx].fb);
+      q.add_tex(t.tex_id, box, alpha, true, st); return;
+    }
+    if (*wallpaper) q.add_tex((*wallpaper)->tex_id, box, alpha, true, st);
+    else q.add_rect(box, {0.12f, 0.12f, 0.14f, alpha}, st);
+    if (ws_idx < 0 || ws_idx >= (int)activities->ws_windows.size()) return;
+    auto og = output->get_layout_geometry();
+    float sxf = (float)box.width / og.width, syf = (float)box.height / og.height;
+    timespec now; clock_gettime(CLOCK_MONOTONIC, &now);
+    for (auto &s : activities->ws_windows[ws_idx].slots) {
+      if (!s.view || !s.view->is_mapped() || s.dragged) continue;
+      auto g = s.anim.current(); glm::vec4 uv;
+      wf::geometry_t wb = {box.x + (int)(g.x * sxf), box.y + (int)(box.height - (g.y + g.height) * syf), (int)(g.width * sxf), (int)(g.height * syf)};
+      auto *tex = view_texture(s.view, s.view->get_geometry(), wb, uv);
+      if (!tex) continue;
+      q.draw_texture(wf::gles_texture_t{tex}, uv, wb, alpha * (s.hovered ? 1.0f : 0.88f), true, 0);
+      wlr_surface_send_frame_done(s.view->get_wlr_surface(), &now);
+    }
+  }
+
+  // Where slot s's app icon goes on a workspace preview at box (render coordinates)
+  wf::geometry_t icon_box(const window_slot_t &s, wf::geometry_t box) const {
+    auto og = output->get_layout_geometry();
+    float sxf = (float)box.width / og.width;
+    float syf = (float)box.height / og.height;
+    int isz = activities->icon_size;
+    auto ws = s.anim.current();
+    float ws_cx = ws.x + ws.width / 2.0f;
+    float ws_bot = ws.y + ws.height;
+    float icon_render_sz = isz * sxf;
+    if (icon_render_sz < isz * 0.5f) icon_render_sz = isz * 0.5f;
+    float irx = box.x + ws_cx * sxf - icon_render_sz / 2.0f;
+    float win_bot_ry = box.y + box.height * (1.0f - ws_bot / (float)og.height);
+    float inset_px = 10.0f * syf;
+    float iry = win_bot_ry + inset_px;
+    float win_top_ry = box.y + box.height * (1.0f - ws.y / (float)og.height);
+    float max_ry = win_top_ry - icon_render_sz - 4.0f;
+    if (iry > max_ry) iry = max_ry;
+    return {(int)irx, (int)iry, (int)icon_render_sz, (int)icon_render_sz};
+  }
+
+  // Queues the app icons drawn on top of workspace ws_idx's windows, with the
+  // workspace preview at box (render coordinates)
+  void add_ws_icons(quad_batch_t &q, int ws_idx, wf::geometry_t box, float alpha_mul) {
+    if (ws_idx < 0 || ws_idx >= (int)activities->ws_windows.size()) return;
+    auto &drg = activities->drag;
+    for (auto &s : activities->ws_windows[ws_idx].slots) {
+      if (!s.icon || !s.icon->tex_id) continue;
+      if (drg.active && s.view == drg.view) continue;
+      float icon_alpha = (s.hovered ? 1.0f : 0.90f) * alpha_mul;
+      q.add_tex_region(s.icon->tex_id, s.icon->slot.uv, icon_box(s, box), icon_alpha, true);
+    }
+  }
+
+  // Every spot icon is drawn at right now, in layout coordinates: on the zooming
+  // workspace or the visible large previews, as do_render places them
+  wf::region_t icon_damage(const icon_tex_t *icon) const {
+    wf::region_t r; auto og = output->get_layout_geometry();
+    bool zooming = activities->desktop_anim.is_animating();
+    for (int i = 0; i < (int)activities->ws_windows.size(); i++) {
+      wf::geometry_t box;
+      if (zooming) { if (i != activities->get_animating_ws()) continue; box = activities->desktop_anim.current(); }
+      else if (activities->is_large_ws_visible(i)) box = activities->get_large_ws_render_geo(i);
+      else continue;
+      box.x += og.x; box.y += og.y;
+      for (auto &s : activities->ws_windows[i].slots) {
+        if (s.icon.get() != icon) continue;
+        auto b = to_layout(icon_box(s, box));
+        r |= wf::geometry_t{b.x - 1, b.y - 1, b.width + 2, b.height + 2};  // bilinear edge
+      }
+    }
+    return r;
+  }
+
+  // All quads go through one batch; borders and the drag shadow are part of the quad
+  // they decorate, so each layer costs one draw per distinct texture. Icons come from
+  // the shared atlas and are queued last, i.e. usually a single draw.
   void do_render(const wf::scene::render_instruction_t &data, std::vector<ws_capture_t> &caps) {
     data.pass->custom_gles_subpass([&] {
+      auto prof = profiler->scope(PHASE_COMPOSITE);
+      profiler->begin_gpu(PHASE_COMPOSITE);
+      int hud_w = 0, hud_h = 0;
+      GLuint hud_tex = profiler->enabled ? profiler->hud_texture(hud_w, hud_h) : 0;
       auto og = output->get_layout_geometry();
-      glClearColor(0, 0, 0, 1); glClear(GL_COLOR_BUFFER_BIT);
-
       float cr = activities->corner_radius;
       auto &drg = activities->drag;
       int total = activities->total_ws;
+      auto &q = progs->quads;
+      q.begin(og, data.target, data.damage);
+      q.clear({0, 0, 0, 1});
 
-      // Wallpaper + dark overlay
-      if (wallpaper_tex) {
+      // Wallpaper + dark overlay; degraded, the wallpaper is darkened in the same quad
+      // instead (equal for an opaque image, one full-screen blend less)
+      if (*wallpaper) {
         wf::geometry_t bg = {og.x, og.y, og.width, og.height};
-        render_tex(progs->tex, output, wallpaper_tex, bg, 1.0f, true);
-        render_rect(progs->col, output, bg, {0, 0, 0, 0.55f});
+        if (degrade >= 1) q.add_tex_tinted((*wallpaper)->tex_id, bg, {0.45f, 0.45f, 0.45f, 1.0f}, true);
+        else { q.add_tex((*wallpaper)->tex_id, bg, 1.0f, true); q.add_rect(bg, {0, 0, 0, 0.55f}); }
       }
 
       // ============================================================
       // Render small workspace thumbnails at bottom
       // ============================================================
       auto &wsg = activities->ws_geos;
-      for (int i = 0; i < (int)wsg.size() && i < (int)caps.size(); i++) {
-        wf::geometry_t g = {og.x + wsg[i].x, og.y + wsg[i].y, wsg[i].width, wsg[i].height};
+      int nthumbs = std::min((int)wsg.size(), (int)caps.size());
+      auto thumb_box = [&](int i) { return wf::geometry_t{og.x + wsg[i].x, og.y + wsg[i].y, wsg[i].width, wsg[i].height}; };
+      for (int i = 0; i < nthumbs; i++) {
         float a = (i == activities->focused_ws) ? 1.0f : 0.5f;
-        if (drg.active && drg.hover_ws == i && i != activities->focused_ws) a = 0.9f;
-        auto t = wf::gles_texture_t::from_aux(caps[i].fb);
-
-        if (drg.active && drg.hover_ws == i && i != activities->focused_ws) {
-          wf::geometry_t border = {g.x - 2, g.y - 2, g.width + 4, g.height + 4};
-          render_rect(progs->col, output, border, {0.3f, 0.55f, 1.0f, 0.6f});
-        }
-        if (i == activities->focused_ws) {
-          wf::geometry_t border = {g.x - 1, g.y - 1, g.width + 2, g.height + 2};
-          render_rect(progs->col, output, border, {1.0f, 1.0f, 1.0f, 0.25f});
-        }
-        render_rounded(progs->rounded, output, t.tex_id, g, a, cr * 0.5f, true);
+        quad_style_t st; st.radius = cr * 0.5f;
+        if (drg.active && drg.hover_ws == i && i != activities->focused_ws) { a = 0.9f; st.border = 2; st.border_color = {0.3f, 0.55f, 1.0f, 0.6f}; }
+        if (i == activities->focused_ws) { st.border = 1; st.border_color = {1.0f, 1.0f, 1.0f, 0.25f}; }
+        add_ws_preview(q, caps, i, thumb_box(i), a, st, true);
       }
 
       // ============================================================
@@ -1145,125 +2486,55 @@ public:
         if (dg.width > 0 && dg.height > 0 && fws >= 0 && fws < (int)caps.size()) {
           float sf = (float)dg.width / og.width;
           float rad = std::clamp(cr * 2.0f * (1.0f - sf), 0.0f, cr * 2.0f);
-          auto t = wf::gles_texture_t::from_aux(caps[fws].fb);
-          if (rad > 1) render_rounded(progs->rounded, output, t.tex_id, dg, 1.0f, rad, true);
-          else render_tex(progs->tex, output, t.tex_id, dg, 1.0f, true);
-
+          quad_style_t st; st.radius = rad > 1 ? rad : 0.0f;
+          add_ws_preview(q, caps, fws, dg, 1.0f, st, false);
           // Icons during zoom (same as paste 3)
-          if (fws < (int)activities->ws_windows.size()) {
-            auto &wd = activities->ws_windows[fws];
-            float sxf = (float)dg.width / og.width;
-            float syf = (float)dg.height / og.height;
-            int isz = activities->icon_size;
-            for (auto &s : wd.slots) {
-              if (!s.icon.tex_id) continue;
-              if (drg.active && s.view == drg.view) continue;
-              auto ws = s.anim.current();
-              float ws_cx = ws.x + ws.width / 2.0f;
-              float ws_bot = ws.y + ws.height;
-              float icon_render_sz = isz * sxf;
-              if (icon_render_sz < isz * 0.5f) icon_render_sz = isz * 0.5f;
-              float irx = dg.x + ws_cx * sxf - icon_render_sz / 2.0f;
-              float win_bot_ry = dg.y + dg.height * (1.0f - ws_bot / (float)og.height);
-              float inset_px = 10.0f * syf;
-              float iry = win_bot_ry + inset_px;
-              float win_top_ry = dg.y + dg.height * (1.0f - ws.y / (float)og.height);
-              float max_ry = win_top_ry - icon_render_sz - 4.0f;
-              if (iry > max_ry) iry = max_ry;
-              wf::geometry_t icon_box = {(int)irx, (int)iry, (int)icon_render_sz, (int)icon_render_sz};
-              float icon_alpha = s.hovered ? 1.0f : 0.90f;
-              render_tex(progs->tex, output, s.icon.tex_id, icon_box, icon_alpha, true);
-            }
-          }
+          if (degrade < 1) add_ws_icons(q, fws, dg, 1.0f);
         }
       } else {
         // ---- CAROUSEL MODE: all workspaces at carousel positions ----
-        for (int i = 0; i < total && i < (int)caps.size(); i++) {
-          auto rg = activities->get_large_ws_render_geo(i);
-
+        auto large_box = [&](int i) { auto rg = activities->get_large_ws_render_geo(i); return wf::geometry_t{og.x + rg.x, og.y + rg.y, rg.width, rg.height}; };
+        int n = std::min(total, (int)caps.size());
+        for (int i = 0; i < n; i++) {
           // Skip if completely off-screen
-          if (rg.x + rg.width < -rg.width || rg.x > og.width + rg.width) continue;
-
-          // Convert to global screen coords
-          wf::geometry_t gl_box = {og.x + rg.x, og.y + rg.y,
-                                   rg.width, rg.height};
-
+          if (!activities->is_large_ws_visible(i)) continue;
           float alpha = (i == fws) ? 1.0f : 0.65f;
-          if (drg.active && drg.hover_large_ws == i) alpha = 0.95f;
-
-          auto t = wf::gles_texture_t::from_aux(caps[i].fb);
-
-          if (i == fws) {
-            wf::geometry_t border = {gl_box.x - 2, gl_box.y - 2, gl_box.width + 4, gl_box.height + 4};
-            render_rect(progs->col, output, border, {1.0f, 1.0f, 1.0f, 0.12f});
-          }
-          if (drg.active && drg.hover_large_ws == i) {
-            wf::geometry_t border = {gl_box.x - 3, gl_box.y - 3, gl_box.width + 6, gl_box.height + 6};
-            render_rect(progs->col, output, border, {0.3f, 0.55f, 1.0f, 0.5f});
-          }
-
-          render_rounded(progs->rounded, output, t.tex_id, gl_box, alpha, cr, true);
-
-          // App icons ON windows
-          if (i < (int)activities->ws_windows.size()) {
-            auto &wd = activities->ws_windows[i];
-            float sxf = (float)rg.width / og.width;
-            float syf = (float)rg.height / og.height;
-            int isz = activities->icon_size;
-
-            for (auto &s : wd.slots) {
-              if (!s.icon.tex_id) continue;
-              if (drg.active && s.view == drg.view) continue;
-
-              auto ws = s.anim.current();
-              float ws_cx = ws.x + ws.width / 2.0f;
-              float ws_bot = ws.y + ws.height;
-
-              float icon_render_sz = isz * sxf;
-              if (icon_render_sz < isz * 0.5f) icon_render_sz = isz * 0.5f;
-
-              float irx = gl_box.x + ws_cx * sxf - icon_render_sz / 2.0f;
-              float win_bot_ry = gl_box.y + gl_box.height * (1.0f - ws_bot / (float)og.height);
-              float inset_px = 10.0f * syf;
-              float iry = win_bot_ry + inset_px;
-              float win_top_ry = gl_box.y + gl_box.height * (1.0f - ws.y / (float)og.height);
-              float max_ry = win_top_ry - icon_render_sz - 4.0f;
-              if (iry > max_ry) iry = max_ry;
-
-              wf::geometry_t icon_box = {(int)irx, (int)iry, (int)icon_render_sz, (int)icon_render_sz};
-              float icon_alpha = s.hovered ? 1.0f : 0.90f;
-              if (i != fws) icon_alpha *= 0.6f;
-              render_tex(progs->tex, output, s.icon.tex_id, icon_box, icon_alpha, true);
-            }
-          }
+          quad_style_t st; st.radius = cr;
+          if (i == fws) { st.border = 2; st.border_color = {1.0f, 1.0f, 1.0f, 0.12f}; }
+          if (drg.active && drg.hover_large_ws == i) { alpha = 0.95f; st.border = 3; st.border_color = {0.3f, 0.55f, 1.0f, 0.5f}; }
+          add_ws_preview(q, caps, i, large_box(i), alpha, st, false);
         }
+        // App icons ON windows
+        for (int i = 0; i < n; i++)
+          if (activities->is_large_ws_visible(i)) add_ws_icons(q, i, large_box(i), i != fws ? 0.6f : 1.0f);
       }
 
       // ============================================================
       // Panel
       // ============================================================
       if (panel && panel->tex_id)
-        render_tex(progs->tex, output, panel->tex_id, panel->get_render_geometry(), 1.0f, true);
+        q.add_tex(panel->tex_id, panel->get_render_geometry(), 1.0f, true);
 
       // ============================================================
       // Floating drag thumbnail
       // ============================================================
-      if (drg.active && drg.has_snapshot && drg.float_width > 0 && drg.float_height > 0) {
-        auto snap_t = wf::gles_texture_t::from_aux(drg.snapshot_fb);
-        float sdx = drg.current_cursor.x - drg.grab_cursor.x;
-        float sdy = drg.current_cursor.y - drg.grab_cursor.y;
-        float scx = drg.initial_screen_geo.x + drg.initial_screen_geo.width / 2.0f + sdx;
-        float scy = drg.initial_screen_geo.y + drg.initial_screen_geo.height / 2.0f + sdy;
-        int fw = drg.float_width, fh = drg.float_height;
-        wf::geometry_t fb = {
-          og.x + (int)(scx - fw / 2.0f),
-          og.y + (int)(og.height - scy - fh / 2.0f),
-          fw, fh
-        };
-        wf::geometry_t shadow = {fb.x + 4, fb.y - 4, fw, fh};
-        render_rect(progs->col, output, shadow, {0, 0, 0, 0.35f});
-        render_rounded(progs->rounded, output, snap_t.tex_id, fb, 0.95f, cr, true);
+      if (drg.active && drg.view && drg.view->is_mapped() && drg.float_width > 0 && drg.float_height > 0) {
+        auto fb = drag_float_box();
+        quad_style_t st; st.radius = cr;
+        st.shadow_offset = {4, -4}; st.shadow_alpha = 0.35f; st.shadow_softness = 3;
+        q.add_shadow(fb, st);
+        glm::vec4 uv;
+        if (auto *tex = view_texture(drg.view, drg.view_geo, fb, uv)) {
+          q.draw_texture(wf::gles_texture_t{tex}, uv, fb, 0.95f, true, cr);
+          // Direct mode skips the dragged slot, so only this draw keeps its client redrawing
+          if (direct) { timespec now; clock_gettime(CLOCK_MONOTONIC, &now); wlr_surface_send_frame_done(drg.view->get_wlr_surface(), &now); }
+        }
       }
+
+      // Profiler HUD, top left just below the panel
+      if (hud_tex) q.add_tex(hud_tex, {og.x + 8, og.y + og.height - (panel_height() + 8) - hud_h, hud_w, hud_h}, 1.0f, true);
+      q.flush();
+      profiler->end_gpu(PHASE_COMPOSITE);
     });
   }
 };
@@ -1276,77 +2547,127 @@ class overview_output_t : public wf::per_output_plugin_instance_t {
 public:
   std::unique_ptr<top_panel_t> panel;
   std::unique_ptr<activities_view_t> activities;
-  std::shared_ptr<overview_node_t> render_node;
+  icon_cache_t *icons = nullptr;
+  std::shared_ptr<overview_node_t> render_node;  // kept across toggles, see park_captures()
+  bool render_node_shown = false;
+  wf::wl_timer<false> capture_idle_timer;
+  bool prewarm = false;
+  wf::wl_timer<true> prewarm_timer;
+  bool direct_compositing = false;
+  frame_governor_t governor; bool governor_last_anim = false;
   std::shared_ptr<panel_node_t> panel_node;
-  gl_programs_t progs;
-  GLuint wallpaper_tex = 0;
-  std::string wallpaper_path;
-  wf::activator_callback toggle_cb;
-  wf::wl_timer<false> clock_timer;
+  std::shared_ptr<gl_programs_t> progs;  // shared by all outputs, see gpu_resources_t
+  gpu_resources_t *gpu = nullptr;
+  frame_profiler_t profiler;
+  wf::wl_timer<true> profile_timer;
+  std::shared_ptr<wallpaper_tex_t> wallpaper;  // shared with the other outputs
+  wf::activator_callback toggle_cb, bench_cb;
+  wf::wl_timer<true> clock_timer;
   wf::effect_hook_t pre_hook;
   bool hooks_active = false;
   int panel_height = 16, corner_radius = 12, spacing = 20, anim_duration = 300;
+  int capture_idle_timeout = 30, capture_memory_cap = 256;  // seconds, MiB
   std::string panel_color = "#1a1a1aE6";
+  wf::signal::connection_t<wf::view_mapped_signal> on_view_mapped = [this](wf::view_mapped_signal *ev) {
+    activities->handle_view_mapped(wf::toplevel_cast(ev->view)); damage_relayout(activities->relayout_ws);
+  };
+  wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped = [this](wf::view_unmapped_signal *ev) {
+    activities->handle_view_unmapped(ev->view); damage_relayout(activities->relayout_ws);
+  };
+  wf::signal::connection_t<wf::view_geometry_changed_signal> on_view_geometry_changed = [this](wf::view_geometry_changed_signal *ev) {
+    activities->handle_view_geometry_changed(wf::toplevel_cast(ev->view)); damage_relayout(activities->relayout_ws);
+  };
+  bool fullscreen_promoted = false;
+  wf::signal::connection_t<wf::fullscreen_layer_focused_signal> on_fullscreen_focused = [this](wf::fullscreen_layer_focused_signal *ev) {
+    set_fullscreen_promoted(ev->has_promoted);
+  };
   bool button_held = false;
   wf::pointf_t press_pos{0, 0};
+  // While the overview hooks run, motion is only recorded and handled once per frame
+  wf::pointf_t pending_motion{0, 0}; bool motion_pending = false;
   bool drag_started = false;
   static constexpr float DRAG_THRESHOLD = 8.0f;
 
-  void load_wallpaper() {
-    if (wallpaper_path.empty()) return;
-    auto img = cairo_image_surface_create_from_png(wallpaper_path.c_str());
-    if (cairo_surface_status(img) != CAIRO_STATUS_SUCCESS) { cairo_surface_destroy(img); return; }
-    int w = cairo_image_surface_get_width(img), h = cairo_image_surface_get_height(img);
-    auto data = cairo_image_surface_get_data(img);
-    wf::gles::run_in_context([&] {
-      if (!wallpaper_tex) glGenTextures(1, &wallpaper_tex);
-      glBindTexture(GL_TEXTURE_2D, wallpaper_tex);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, data);
-      glBindTexture(GL_TEXTURE_2D, 0);
-    });
-    cairo_surface_destroy(img);
+  void set_wallpaper(std::shared_ptr<wallpaper_tex_t> wp) {
+    if (wp == wallpaper) return;
+    wallpaper = std::move(wp); damage_overview();
   }
 
   void init() override {
     panel = std::make_unique<top_panel_t>(output, panel_height, panel_color);
     activities = std::make_unique<activities_view_t>(output);
     activities->set_config(corner_radius, spacing, panel_height, anim_duration);
-    wf::gles::run_in_context([&] { progs.load(); });
-    load_wallpaper();
+    activities->icons = icons;
+    progs = gpu->programs();
 
     pre_hook = [this]() {
+      if (motion_pending) { motion_pending = false; handle_motion(pending_motion); }
+      float period_ms = output->handle->refresh > 0 ? 1e6f / output->handle->refresh : 1000.0f / 60;
+      if (governor.frame(governor_last_anim, period_ms)) apply_quality();
+      // The composite only repaints damage, so the HUD asks for its own refresh
+      if (profiler.enabled && render_node_shown && profiler.hud_due()) {
+        auto og = output->get_layout_geometry(); auto hs = profiler.hud_size();
+        wf::geometry_t hb = {og.x + 8, og.y + panel->height + 8, hs.width, hs.height};
+        wf::scene::damage_node(render_node, hs.width > 0 ? wf::region_t{hb} : wf::region_t{render_node->get_bounding_box()});
+      }
       bool wa = activities->is_animating, wd = activities->drag.active;
       bool wc = activities->carousel_scroll.is_animating();
-      activities->tick();
+      // Copied before the tick, so the frame a relayout settles on is repainted too
+      auto relayout = activities->relayout_ws;
+      { auto prof = profiler.scope(PHASE_TICK); activities->tick(); activities->prune_relayout(); }
       bool sa = activities->is_animating, sd = activities->drag.active;
       bool sc = activities->carousel_scroll.is_animating();
-      if (sa || sd || sc) {
+      governor_last_anim = sa || sc || !relayout.empty();
+      if (!sa && !sc) damage_relayout(relayout);
+      if (sa || sc) {
         if (render_node) wf::scene::damage_node(render_node, render_node->get_bounding_box());
         output->render->schedule_redraw();
+      } else if (sd) {
+        damage_drag();
       } else if ((wa || wd || wc) && !sa && !activities->is_active) {
         output->render->damage_whole(); deactivate_hooks();
       }
     };
 
-    clock_timer.set_timeout(60000, [this]() {
-      panel->render(); panel->upload();
-      if (panel_node) wf::scene::damage_node(panel_node, panel_node->get_bounding_box());
+    // Polled every few seconds so the minute flips on time; only redraws on change
+    clock_timer.set_timeout(5000, [this]() {
+      auto old = panel->clock_bounds;
+      if (panel->update_clock()) {
+        auto nb = panel->clock_bounds; panel->upload();
+        if (panel_node) { wf::region_t r{panel->to_layout(old)}; r |= panel->to_layout(nb); wf::scene::damage_node(panel_node, r); }
+      }
       return true;
     });
 
-    panel_node = std::make_shared<panel_node_t>(output, panel.get(), &progs, &activities->is_active);
+    output->connect(&on_view_mapped); output->connect(&on_view_unmapped); output->connect(&on_view_geometry_changed);
+
+    panel_node = std::make_shared<panel_node_t>(output, panel.get(), progs.get(), &activities->is_active);
     wf::scene::add_front(wf::get_core().scene(), panel_node);
     wf::scene::damage_node(panel_node, panel_node->get_bounding_box());
+    output->connect(&on_fullscreen_focused);
+    auto top = output->wset()->get_views(wf::WSET_CURRENT_WORKSPACE | wf::WSET_MAPPED_ONLY | wf::WSET_SORT_STACKING);
+    auto tv = top.empty() ? nullptr : wf::toplevel_cast(top.front());
+    set_fullscreen_promoted(tv && tv->pending_fullscreen());
+  }
+
+  // A fullscreen view on top gets the output to itself: the panel node is disabled so
+  // nothing is composited over it and the view can be scanned out directly. The
+  // overview draws its own copy of the panel, so only the closed state is affected.
+  void set_fullscreen_promoted(bool p) {
+    if (fullscreen_promoted == p) return;
+    fullscreen_promoted = p;
+    if (!panel_node) return;
+    wf::scene::set_node_enabled(panel_node, !p);
+    if (p) panel->set_hover(false);
+    output->render->damage(panel->get_geometry());
   }
+  bool panel_shown() const { return !fullscreen_promoted || activities->is_active; }
 
   void activate_hooks() {
     if (hooks_active) return;
-    if (!render_node) {
-      render_node = std::make_shared<overview_node_t>(output, activities.get(), &progs, wallpaper_tex, panel.get());
-      wf::scene::add_front(wf::get_core().scene(), render_node);
-    }
+    capture_idle_timer.disconnect(); prewarm_timer.disconnect();
+    ensure_render_node();
+    if (!render_node_shown) { wf::scene::add_front(wf::get_core().scene(), render_node); render_node_shown = true; }
     if (panel_node) {
       wf::scene::remove_child(panel_node);
       wf::scene::add_front(wf::get_core().scene(), panel_node);
@@ -1357,40 +2678,150 @@ public:
 
   void deactivate_hooks() {
     if (!hooks_active) return;
-    output->render->rem_effect(&pre_hook); hooks_active = false;
-    if (render_node) { wf::scene::remove_child(render_node); render_node = nullptr; }
+    output->render->rem_effect(&pre_hook); hooks_active = false; governor_last_anim = false;
+    if (render_node_shown) { wf::scene::remove_child(render_node); render_node_shown = false; }
+    park_captures();
     if (panel_node) wf::scene::damage_node(panel_node, panel_node->get_bounding_box());
     output->render->damage_whole();
-    button_held = false; drag_started = false;
+    button_held = false; drag_started = false; motion_pending = false;
+  }
+
+  void ensure_render_node() {
+    if (render_node) return;
+    render_node = std::make_shared<overview_node_t>(output, activities.get(), progs.get(), &wallpaper, panel.get(), &profiler);
+    render_node->direct = direct_compositing; render_node->degrade = governor.level;
+  }
+
+  void apply_quality() {
+    LOGI("overview: quality level ", governor.level, " on ", output->to_string());
+    if (!render_node) return;
+    render_node->degrade = governor.level;
+    if (render_node_shown) output->render->damage_whole();
+  }
+
+  void set_governor(bool on, int max_level, int miss_percent) {
+    governor.enabled = on; governor.max_level = std::clamp(max_level, 0, 3); governor.miss_percent = miss_percent;
+    int old = governor.level;
+    governor.level = on ? std::min(governor.level, governor.max_level) : 0;
+    if (governor.level != old) apply_quality();
+  }
+
+  // Captures are not needed in direct mode and are rebuilt when leaving it
+  void set_direct_compositing(bool on) {
+    direct_compositing = on;
+    if (!render_node) return;
+    render_node->direct = on; render_node->release_captures();
+    if (render_node_shown) output->render->damage_whole();
+  }
+
+  // The hidden node keeps its captures for the next activation unless they exceed the
+  // memory cap; after capture_idle_timeout seconds without one they are freed too
+  void park_captures() {
+    if (!render_node) return;
+    if (capture_idle_timeout <= 0 || render_node->capture_bytes > (size_t)capture_memory_cap << 20) {
+      render_node->release_captures(); return;
+    }
+    capture_idle_timer.set_timeout(capture_idle_timeout * 1000, [this]() { if (render_node && !render_node_shown) render_node->release_captures(); });
+  }
+
+  // Opt-in: the overview is probably about to open, so render the captures its first
+  // frame needs one per event-loop turn, and start the icon lookups
+  void start_prewarm() {
+    if (!prewarm || hooks_active || activities->is_active || prewarm_timer.is_connected()) return;
+    capture_idle_timer.disconnect();
+    ensure_render_node();
+    activities->prepare_geometry(); activities->warm_icons();
+    prewarm_timer.set_timeout(1, [this]() {
+      if (hooks_active || render_node->prewarm_step()) return !hooks_active;
+      park_captures(); return false;
+    });
+  }
+
+  // Percentiles (p50/p95/p99, ms) go to the log every few seconds while enabled
+  void set_profiling(bool on) {
+    profiler.enabled = on;
+    if (!on) { profile_timer.disconnect(); damage_overview(); return; }
+    if (profile_timer.is_connected()) return;
+    profile_timer.set_timeout(5000, [this]() {
+      LOGI("overview profile (", output->to_string(), "):\n", profiler.summary());
+      return true;
+    });
+  }
+
+  // Estimate of what the overview holds in GPU memory on this output
+  size_t gpu_bytes() const {
+    size_t b = (wallpaper ? wallpaper->bytes() : 0) + (size_t)panel->width * panel->height * 4;
+    if (render_node) b += render_node->capture_bytes;  // also while parked
+    if (icons) b += icons->gpu_bytes();
+    return b;
+  }
+
+  void damage_drag() {
+    if (!render_node) return;
+    auto r = render_node->drag_damage();
+    if (!r.empty()) wf::scene::damage_node(render_node, r);
+  }
+
+  // Repaints where workspaces ws are drawn, e.g. while their slots move after a live update
+  void damage_relayout(const std::vector<int> &ws) {
+    if (!render_node_shown || ws.empty()) return;
+    wf::region_t r;
+    for (int wi : ws) for (auto &b : render_node->ws_screen_boxes(wi)) r |= b;
+    wf::scene::damage_node(render_node, r); output->render->schedule_redraw();
+  }
+
+  void damage_icon(const icon_tex_t *icon) {
+    if (!render_node_shown) return;
+    auto r = render_node->icon_damage(icon);
+    if (!r.empty()) { wf::scene::damage_node(render_node, r); output->render->schedule_redraw(); }
+  }
+
+  void damage_overview() {
+    if (render_node_shown) { wf::scene::damage_node(render_node, render_node->get_bounding_box()); output->render->schedule_redraw(); }
   }
 
   void toggle() {
-    activities->toggle();
+    {
+      frame_profiler_t::scope_t prof(activities->is_active ? nullptr : &profiler, PHASE_ACTIVATE);
+      activities->toggle();
+    }
     if (activities->is_active) activate_hooks();
     output->render->damage_whole();
   }
 
   void fini() override {
     if (hooks_active) { output->render->rem_effect(&pre_hook); hooks_active = false; }
-    if (render_node) { wf::scene::remove_child(render_node); render_node = nullptr; }
+    capture_idle_timer.disconnect(); prewarm_timer.disconnect();
+    if (render_node_shown) { wf::scene::remove_child(render_node); render_node_shown = false; }
+    if (render_node) { render_node->release_captures(); render_node = nullptr; }
     if (panel_node) { wf::scene::remove_child(panel_node); panel_node = nullptr; }
-    clock_timer.disconnect();
+    clock_timer.disconnect(); profile_timer.disconnect();
+    on_view_mapped.disconnect(); on_view_unmapped.disconnect(); on_view_geometry_changed.disconnect();
+    on_fullscreen_focused.disconnect();
     wf::gles::run_in_context_if_gles([&] {
-      progs.free();
-      if (wallpaper_tex) { glDeleteTextures(1, &wallpaper_tex); wallpaper_tex = 0; }
+      profiler.free();
     });
+    wallpaper = nullptr; progs = nullptr;
     activities.reset(); panel.reset();
   }
 
+  void queue_motion(wf::pointf_t cursor) {
+    if (!hooks_active) { handle_motion(cursor); return; }
+    pending_motion = cursor;
+    if (!motion_pending) { motion_pending = true; output->render->schedule_redraw(); }
+  }
+
   void handle_motion(wf::pointf_t cursor) {
     auto og = output->get_layout_geometry();
-    bool in_panel = cursor.y >= og.y && cursor.y < og.y + panel->height;
+    bool in_panel = panel_shown() && cursor.y >= og.y && cursor.y < og.y + panel->height;
     if (in_panel) {
-      if (panel->set_hover(panel->point_in_activities(cursor)))
-        wf::scene::damage_node(panel_node, panel_node->get_bounding_box());
+      if (panel->set_hover(panel->point_in_activities(cursor))) {
+        wf::scene::damage_node(panel_node, panel->to_layout(panel->activities_bounds));
+        if (panel->activities_hovered) start_prewarm();
+      }
     } else if (panel->activities_hovered) {
       if (panel->set_hover(false))
-        wf::scene::damage_node(panel_node, panel_node->get_bounding_box());
+        wf::scene::damage_node(panel_node, panel->to_layout(panel->activities_bounds));
     }
 
     if (activities->is_active && !activities->is_animating) {
@@ -1403,24 +2834,24 @@ public:
         }
       }
       if (drag_started && activities->drag.active) {
-        activities->update_drag(local, cursor);
-        if (render_node) {
-          wf::scene::damage_node(render_node, render_node->get_bounding_box());
-          output->render->schedule_redraw();
-        }
+        activities->update_drag(local, cursor); damage_drag();
       } else {
         auto old = activities->hovered_view;
+        auto old_rect = activities->hover_damage_rect(old);
         activities->update_hover(local);
-        if (old != activities->hovered_view && render_node)
-          wf::scene::damage_node(render_node, render_node->get_bounding_box());
+        if (old != activities->hovered_view && render_node) {
+          wf::region_t r{old_rect}; r |= activities->hover_damage_rect(activities->hovered_view);
+          wf::scene::damage_node(render_node, r);
+        }
       }
     }
   }
 
   bool handle_button(uint32_t btn, uint32_t state, wf::pointf_t cursor) {
     if (btn != BTN_LEFT) return false;
+    if (motion_pending) { motion_pending = false; handle_motion(pending_motion); }
     if (state == WL_POINTER_BUTTON_STATE_PRESSED) {
-      if (panel->point_in_activities(cursor)) { toggle(); return true; }
+      if (panel_shown() && panel->point_in_activities(cursor)) { toggle(); return true; }
       if (activities->is_active && !activities->is_animating) {
         button_held = true; press_pos = cursor; drag_started = false; return true;
       }
@@ -1446,6 +2877,159 @@ public:
   }
 };
 
+// ============================================================================
+// Scripted Benchmark — enter, scroll through every workspace, drag, exit
+// ============================================================================
+
+// Runs the overview through a fixed scenario on one output and logs a single
+// "overview-bench:" line with frame times, activation latency and GPU memory.
+// tools/overview-bench.sh drives it on the headless backend. The windows it spreads
+// and drags are put back afterwards, so a run from the keybinding leaves the session as it was.
+class overview_bench_t {
+  enum step_t { ENTER, WAIT_ENTER, SCROLL, WAIT_SCROLL, DRAG, WAIT_DRAG, EXIT, WAIT_EXIT, DONE };
+  using clock = std::chrono::steady_clock;
+  static float ms_since(clock::time_point t) { return std::chrono::duration<float, std::milli>(clock::now() - t).count(); }
+
+  overview_output_t *o;
+  int rounds, round = 0, scroll_to = 0, drag_step = 0;
+  step_t step = ENTER;
+  clock::time_point step_start, last_frame{};
+  std::vector<float> frame_ms, activate_ms, enter_ms, exit_ms;
+  size_t peak_gpu = 0;
+  wf::wl_timer<true> step_timer;
+  wf::effect_hook_t frame_hook;
+  std::function<void()> on_done;
+  // Workspace and window positions from before spread_views, by view id
+  wf::point_t saved_ws{0, 0};
+  std::unordered_map<uint64_t, wf::point_t> saved_pos;
+
+public:
+  overview_bench_t(overview_output_t *out, int r, std::function<void()> done) : o(out), rounds(std::max(r, 1)), on_done(std::move(done)) {}
+  ~overview_bench_t() { stop(); restore_views(); }
+
+  void start() {
+    if (o->activities->is_active) return finish();
+    spread_views();
+    frame_hook = [this]() {
+      auto now = clock::now();
+      if (last_frame != clock::time_point{}) frame_ms.push_back(std::chrono::duration<float, std::milli>(now - last_frame).count());
+      last_frame = now;
+      size_t gpu = o->gpu_bytes(); if (gpu > peak_gpu) peak_gpu = gpu;
+    };
+    o->output->render->add_effect(&frame_hook, wf::OUTPUT_EFFECT_PRE);
+    step_timer.set_timeout(5, [this]() { advance(); return step != DONE; });
+  }
+
+  overview_output_t *output() const { return o; }
+  bool finished() const { return step == DONE; }
+
+  void stop() {
+    step_timer.disconnect();
+    if (frame_hook) { o->output->render->rem_effect(&frame_hook); frame_hook = nullptr; }
+  }
+
+private:
+  // Round-robins the output's windows over the workspace grid so every workspace has some
+  void spread_views() {
+    auto wset = o->output->wset(); auto grid = wset->get_workspace_grid_size();
+    int total = grid.width * grid.height, i = 0;
+    saved_ws = wset->get_current_workspace();
+    for (auto &v : wset->get_views(wf::WSET_MAPPED_ONLY)) {
+      auto tv = wf::toplevel_cast(v);
+      if (!tv || tv->minimized) continue;
+      auto g = tv->get_geometry(); saved_pos[tv->get_id()] = {g.x, g.y};
+      wset->move_to_workspace(tv, {i % grid.width, (i / grid.width) % grid.height}); i = (i + 1) % total;
+    }
+  }
+
+  // Positions are relative to the current workspace, so it goes back first. Windows
+  // closed during the run are simply gone, ones opened since stay where they are.
+  void restore_views() {
+    if (saved_pos.empty()) return;
+    auto wset = o->output->wset(); wset->set_workspace(saved_ws);
+    for (auto &v : wset->get_views(wf::WSET_MAPPED_ONLY)) {
+      auto tv = wf::toplevel_cast(v); auto it = tv ? saved_pos.find(tv->get_id()) : saved_pos.end();
+      if (it != saved_pos.end()) tv->move(it->second.x, it->second.y);
+    }
+    saved_pos.clear();
+  }
+
+  void next(step_t s) { step = s; step_start = clock::now(); }
+
+  void advance() {
+    auto &a = *o->activities;
+    switch (step) {
+      case ENTER: {
+        auto t = clock::now(); o->toggle(); activate_ms.push_back(ms_since(t));
+        step_start = t; step = WAIT_ENTER; break;
+      }
+      case WAIT_ENTER:
+        if (!a.is_animating) { enter_ms.push_back(ms_since(step_start)); scroll_to = 0; next(SCROLL); }
+        break;
+      case SCROLL:
+        if (scroll_to >= a.total_ws) { next(DRAG); break; }
+        a.navigate_to(scroll_to++); o->damage_overview(); next(WAIT_SCROLL);
+        break;
+      case WAIT_SCROLL:
+        if (!a.carousel_scroll.is_animating()) next(SCROLL);
+        break;
+      case DRAG: drag(a); break;
+      case WAIT_DRAG:
+        if (!a.is_animating) next(EXIT);
+        break;
+      case EXIT:
+        o->toggle(); next(WAIT_EXIT); break;
+      case WAIT_EXIT:
+        if (!a.is_active) {
+          exit_ms.push_back(ms_since(step_start));
+          if (++round < rounds) next(ENTER); else finish();
+        }
+        break;
+      case DONE: break;
+    }
+  }
+
+  // Drags the first window of the focused workspace onto the next workspace's
+  // thumbnail over a few frames
+  void drag(activities_view_t &a) {
+    auto og = o->output->get_layout_geometry();
+    int dest = (a.focused_ws + 1) % std::max(a.total_ws, 1);
+    if (a.total_ws < 2 || a.ws_windows[a.focused_ws].slots.empty() || dest >= (int)a.ws_geos.size()) { next(EXIT); return; }
+    auto &g = a.ws_geos[dest];
+    wf::pointf_t to_local{g.x + g.width / 2.0f, og.height - (g.y + g.height / 2.0f)};
+    constexpr int STEPS = 10;
+    if (drag_step == 0) {
+      auto from = a.slot_screen_center(0);
+      if (!a.start_drag(from)) { next(EXIT); return; }
+      drag_step = 1; return;
+    }
+    float t = (float)drag_step / STEPS;
+    wf::pointf_t from = a.drag.grab_cursor;
+    wf::pointf_t l{from.x + (to_local.x - from.x) * t, from.y + (to_local.y - from.y) * t};
+    wf::pointf_t gp{l.x + og.x, l.y + og.y};
+    if (drag_step < STEPS) { a.update_drag(l, gp); drag_step++; }
+    else { a.end_drag(l, gp); drag_step = 0; next(WAIT_DRAG); }
+    o->damage_overview();
+  }
+
+  // The step timer stops itself once step is DONE
+  void finish() {
+    step = DONE;
+    if (frame_hook) { o->output->render->rem_effect(&frame_hook); frame_hook = nullptr; }
+    restore_views();
+    auto pct = [](const std::vector<float> &v) {
+      char b[64]; snprintf(b, sizeof(b), "p50=%.2f p95=%.2f", percentile_of(v, 0.5f), percentile_of(v, 0.95f)); return std::string(b);
+    };
+    auto grid = o->output->wset()->get_workspace_grid_size();
+    float fmax = frame_ms.empty() ? 0 : *std::max_element(frame_ms.begin(), frame_ms.end());
+    char head[128]; snprintf(head, sizeof(head), "windows=%zu workspaces=%dx%d rounds=%d frames=%zu",
+      o->output->wset()->get_views(wf::WSET_MAPPED_ONLY).size(), grid.width, grid.height, round, frame_ms.size());
+    LOGI("overview-bench: ", head, " activate_ms ", pct(activate_ms), " enter_ms ", pct(enter_ms), " exit_ms ", pct(exit_ms),
+         " frame_ms ", pct(frame_ms), " p99=", percentile_of(frame_ms, 0.99f), " max=", fmax, " gpu_peak_kib=", peak_gpu / 1024);
+    if (on_done) on_done();
+  }
+};
+
 // ============================================================================
 // Main Plugin
 // ============================================================================
@@ -1458,42 +3042,114 @@ class wayfire_overview_t : public wf::plugin_interface_t {
   wf::option_wrapper_t<int> opt_spacing{"overview/spacing"};
   wf::option_wrapper_t<wf::activatorbinding_t> opt_toggle{"overview/toggle"};
   wf::option_wrapper_t<std::string> opt_wallpaper{"overview/wallpaper"};
+  wf::option_wrapper_t<int> opt_capture_idle_timeout{"overview/capture_idle_timeout"};
+  wf::option_wrapper_t<int> opt_capture_memory_cap{"overview/capture_memory_cap"};
+  wf::option_wrapper_t<bool> opt_prewarm{"overview/prewarm"};
+  wf::option_wrapper_t<bool> opt_direct_compositing{"overview/direct_compositing"};
+  wf::option_wrapper_t<bool> opt_governor{"overview/governor"};
+  wf::option_wrapper_t<int> opt_governor_max_level{"overview/governor_max_level"};
+  wf::option_wrapper_t<int> opt_governor_miss_percent{"overview/governor_miss_percent"};
+  wf::option_wrapper_t<bool> opt_profile{"overview/profile"};
+  wf::option_wrapper_t<wf::activatorbinding_t> opt_benchmark{"overview/benchmark"};
+  wf::option_wrapper_t<int> opt_benchmark_rounds{"overview/benchmark_rounds"};
+  wf::option_wrapper_t<int> opt_benchmark_autostart{"overview/benchmark_autostart"};
 
   std::map<wf::output_t*, std::unique_ptr<overview_output_t>> outputs;
+  worker_pool_t workers;
+  gpu_resources_t gpu;
+  std::unique_ptr<overview_bench_t> bench;
+  std::pair<wf::output_t*, overview_output_t*> motion_output{nullptr, nullptr};  // last output under the cursor
+  wf::wl_timer<false> bench_autostart_timer;
   wf::signal::connection_t<wf::output_added_signal> on_output_added = [this](wf::output_added_signal *ev) { add_output(ev->output); };
   wf::signal::connection_t<wf::output_removed_signal> on_output_removed = [this](wf::output_removed_signal *ev) { remove_output(ev->output); };
   wf::signal::connection_t<wf::post_input_event_signal<wlr_pointer_motion_event>> on_motion = [this](auto*) { handle_motion(); };
   wf::signal::connection_t<wf::post_input_event_signal<wlr_pointer_button_event>> on_button = [this](auto *ev) { handle_button(ev->event); };
+  // Super down usually precedes the toggle binding, so it is the earliest hint to pre-warm on
+  wf::signal::connection_t<wf::post_input_event_signal<wlr_keyboard_key_event>> on_key = [this](auto *ev) {
+    if (!opt_prewarm || ev->event->state != WL_KEYBOARD_KEY_STATE_PRESSED) return;
+    if (ev->event->keycode != KEY_LEFTMETA && ev->event->keycode != KEY_RIGHTMETA) return;
+    auto c = wf::get_core().get_cursor_position();
+    auto it = outputs.find(wf::get_core().output_layout->get_output_at(c.x, c.y));
+    if (it != outputs.end()) it->second->start_prewarm();
+  };
 
 public:
   void init() override {
     wf::get_core().connect(&on_output_added); wf::get_core().connect(&on_output_removed);
-    wf::get_core().connect(&on_motion); wf::get_core().connect(&on_button);
+    wf::get_core().connect(&on_motion); wf::get_core().connect(&on_button); wf::get_core().connect(&on_key);
+    workers.start(2);
+    gpu.icons.pool = &workers;
+    gpu.icons.on_icon_loaded = [this](const icon_tex_t *icon) { for (auto &[o, i] : outputs) i->damage_icon(icon); };
+    gpu.icons.start();
+    gpu.wallpaper.pool = &workers;
+    gpu.wallpaper.on_loaded = [this]() { for (auto &[o, i] : outputs) i->set_wallpaper(gpu.wallpaper.get()); };
+    opt_wallpaper.set_callback([this]() { load_wallpaper(); });
+    opt_profile.set_callback([this]() { for (auto &[o, i] : outputs) i->set_profiling(opt_profile); });
+    opt_prewarm.set_callback([this]() { for (auto &[o, i] : outputs) i->prewarm = opt_prewarm; });
+    opt_direct_compositing.set_callback([this]() { for (auto &[o, i] : outputs) i->set_direct_compositing(opt_direct_compositing); });
+    auto governor_changed = [this]() { for (auto &[o, i] : outputs) i->set_governor(opt_governor, opt_governor_max_level, opt_governor_miss_percent); };
+    opt_governor.set_callback(governor_changed); opt_governor_max_level.set_callback(governor_changed);
+    opt_governor_miss_percent.set_callback(governor_changed);
     for (auto &o : wf::get_core().output_layout->get_outputs()) add_output(o);
+    // Headless runs: benchmark the first output once, then quit the compositor
+    if (opt_benchmark_autostart > 0) bench_autostart_timer.set_timeout(opt_benchmark_autostart * 1000, [this]() {
+      if (!outputs.empty()) run_benchmark(outputs.begin()->second.get(), [] { wf::get_core().shutdown(); });
+    });
   }
   void fini() override {
-    for (auto &[o, i] : outputs) { o->rem_binding(&i->toggle_cb); i->fini(); }
-    outputs.clear();
+    bench_autostart_timer.disconnect(); bench.reset();
+    gpu.icons.stop(); workers.stop(); gpu.wallpaper.clear();
+    for (auto &[o, i] : outputs) { o->rem_binding(&i->toggle_cb); o->rem_binding(&i->bench_cb); i->fini(); }
+    outputs.clear(); motion_output = {nullptr, nullptr};
+    wf::gles::run_in_context_if_gles([&] { gpu.icons.clear(); });
   }
   void add_output(wf::output_t *out) {
     auto i = std::make_unique<overview_output_t>();
     i->panel_height = opt_panel_height; i->panel_color = (std::string)opt_panel_color;
     i->corner_radius = opt_corner_radius; i->anim_duration = opt_animation_duration;
     i->spacing = opt_spacing; i->output = out;
-    i->wallpaper_path = (std::string)opt_wallpaper;
+    i->capture_idle_timeout = opt_capture_idle_timeout; i->capture_memory_cap = opt_capture_memory_cap;
+    i->prewarm = opt_prewarm; i->direct_compositing = opt_direct_compositing;
+    i->set_governor(opt_governor, opt_governor_max_level, opt_governor_miss_percent);
+    i->wallpaper = gpu.wallpaper.get();
+    i->icons = &gpu.icons; i->gpu = &gpu;
     i->init();
+    i->set_profiling(opt_profile);
     auto *p = i.get();
     i->toggle_cb = [p](auto) { p->toggle(); return true; };
+    i->bench_cb = [this, p](auto) { run_benchmark(p, nullptr); return true; };
     out->add_activator(opt_toggle, &i->toggle_cb);
+    out->add_activator(opt_benchmark, &i->bench_cb);
     outputs[out] = std::move(i);
+    load_wallpaper();
+  }
+  // One decode for all outputs, sized for the largest; a bigger new output triggers a reload
+  void load_wallpaper() {
+    int w = 0, h = 0;
+    for (auto &[o, i] : outputs) { auto sz = o->get_screen_size(); w = std::max(w, sz.width); h = std::max(h, sz.height); }
+    gpu.wallpaper.load(opt_wallpaper, w, h);
   }
   void remove_output(wf::output_t *out) {
-    if (outputs.count(out)) { out->rem_binding(&outputs[out]->toggle_cb); outputs[out]->fini(); outputs.erase(out); }
+    if (!outputs.count(out)) return;
+    if (bench && bench->output() == outputs[out].get()) bench.reset();
+    if (motion_output.first == out) motion_output = {nullptr, nullptr};
+    out->rem_binding(&outputs[out]->toggle_cb); out->rem_binding(&outputs[out]->bench_cb);
+    outputs[out]->fini(); outputs.erase(out);
+  }
+  // A finished run stays around until the next one starts, so its timer can unwind
+  void run_benchmark(overview_output_t *o, std::function<void()> done) {
+    if (bench && !bench->finished()) return;
+    bench = std::make_unique<overview_bench_t>(o, opt_benchmark_rounds, std::move(done));
+    bench->start();
   }
   void handle_motion() {
     auto c = wf::get_core().get_cursor_position();
-    auto o = wf::get_core().output_layout->get_output_at(c.x, c.y);
-    if (o && outputs.count(o)) outputs[o]->handle_motion(c);
+    auto &[o, i] = motion_output;
+    if (!o || !(o->get_layout_geometry() & c)) {
+      o = wf::get_core().output_layout->get_output_at(c.x, c.y);
+      auto it = outputs.find(o); i = it != outputs.end() ? it->second.get() : nullptr;
+    }
+    if (i) i->queue_motion(c);
   }
   void handle_button(wlr_pointer_button_event *ev) {
     auto c = wf::get_core().get_cursor_position();
@@ -0,0 +1,54 @@
+#!/bin/sh
+# Runs the overview's built-in benchmark on Wayfire's headless backend over a sweep of
+# window counts and workspace grids, printing one CSV row per run.
+#
+#   tools/overview-bench.sh [build-dir]
+#
+# WINDOWS, GRIDS, ROUNDS and BENCH_CLIENT override the sweep; BENCH_CLIENT must open
+# one toplevel window per invocation (weston-simple-shm by default).
+
+set -eu
+
+BUILD_DIR=${1:-build}
+WINDOWS=${WINDOWS:-"1 10 50 100 200"}
+GRIDS=${GRIDS:-"1x1 3x3 5x5"}
+ROUNDS=${ROUNDS:-5}
+BENCH_CLIENT=${BENCH_CLIENT:-weston-simple-shm}
+START_DELAY=${START_DELAY:-5}
+
+PLUGIN_DIR=$(cd "$BUILD_DIR/src" && pwd)
+METADATA_DIR=$(cd "$(dirname "$0")/../metadata" && pwd)
+COMMIT=$(git -C "$(dirname "$0")" rev-parse --short HEAD 2>/dev/null || echo unknown)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+echo "commit,windows,grid,rounds,activate_p50,activate_p95,enter_p50,enter_p95,exit_p50,exit_p95,frame_p50,frame_p95,frame_p99,frame_max,gpu_peak_kib"
+
+for grid in $GRIDS; do
+  cols=${grid%x*}; rows=${grid#*x}
+  for n in $WINDOWS; do
+    cat > "$WORK/wayfire.ini" <<INI
+[core]
+plugins = overview autostart
+vwidth = $cols
+vheight = $rows
+
+[overview]
+benchmark_autostart = $START_DELAY
+benchmark_rounds = $ROUNDS
+
+[autostart]
+autostart_wf_shell = false
+clients = sh -c 'i=0; while [ \$i -lt $n ]; do $BENCH_CLIENT & i=\$((i+1)); done; wait'
+INI
+    WLR_BACKENDS=headless WLR_RENDERER=gles2 WLR_HEADLESS_OUTPUTS=1 \
+    WAYFIRE_PLUGIN_PATH="$PLUGIN_DIR" WAYFIRE_PLUGIN_XML_PATH="$METADATA_DIR" \
+      timeout 300 wayfire -c "$WORK/wayfire.ini" > "$WORK/log" 2>&1 || true
+
+    line=$(grep -o 'overview-bench:.*' "$WORK/log" | tail -n 1)
+    if [ -z "$line" ]; then echo "$COMMIT,$n,$grid,$ROUNDS,failed" ; continue; fi
+    # activate_ms, enter_ms, exit_ms and frame_ms each carry p50= and p95=
+    vals=$(echo "$line" | grep -o '\(p50\|p95\|p99\|max\|gpu_peak_kib\)=[0-9.]*' | cut -d= -f2 | paste -sd, -)
+    echo "$COMMIT,$n,$grid,$ROUNDS,$vals"
+  done
+done